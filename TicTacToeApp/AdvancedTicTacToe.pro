@@ -1,7 +1,7 @@
-QT += core gui sql
+QT += core gui sql concurrent
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
-CONFIG += c++11
+CONFIG += c++17
 
 # Main application target
 TEMPLATE = app
@@ -9,14 +9,46 @@ TARGET = AdvancedTicTacToe
 
 SOURCES += \
     main.cpp \
+    batchstatus.cpp \
+    engine.cpp \
     gamelogic.cpp \
     gamewindow.cpp \
-    userauth.cpp
+    mappedfile.cpp \
+    mcts.cpp \
+    openingbook.cpp \
+    openingbook4x4.cpp \
+    perfectplay.cpp \
+    ponderer.cpp \
+    positionrank.cpp \
+    tablebase.cpp \
+    transpositiontable.cpp \
+    userauth.cpp \
+    workstealingpool.cpp
 
 HEADERS += \
+    batchstatus.h \
+    bitboard.h \
+    bitsliced.h \
+    difficulty.h \
+    engine.h \
+    evaluator.h \
     gamelogic.h \
     gamewindow.h \
-    userauth.h
+    mappedfile.h \
+    mcts.h \
+    movelist.h \
+    openingbook.h \
+    perfectplay.h \
+    ponderer.h \
+    positionrank.h \
+    search.h \
+    stoptoken.h \
+    symmetry.h \
+    tablebase.h \
+    transpositiontable.h \
+    userauth.h \
+    workstealingpool.h \
+    zobrist.h
 
 # Test target
 CONFIG(test) {
@@ -28,10 +60,94 @@ CONFIG(test) {
         test_gamelogic.cpp \
         test_ai.cpp \
         test_userauth.cpp \
+        allocationcounter.cpp \
+        batchstatus.cpp \
+        engine.cpp \
         gamelogic.cpp \
-        userauth.cpp
+        mappedfile.cpp \
+        mcts.cpp \
+        openingbook.cpp \
+        openingbook4x4.cpp \
+        perfectplay.cpp \
+        ponderer.cpp \
+        positionrank.cpp \
+        tablebase.cpp \
+        transpositiontable.cpp \
+        userauth.cpp \
+        workstealingpool.cpp
     HEADERS = \
         test_gamelogic.h \
         test_ai.h \
-        test_userauth.h
+        test_userauth.h \
+        allocationcounter.h
+}
+
+# Benchmark target: qmake CONFIG+=benchmark
+CONFIG(benchmark) {
+    TEMPLATE = app
+    TARGET = TicTacToeBench
+    QT += testlib
+    INCLUDEPATH += .
+    SOURCES = \
+        bench_search.cpp \
+        batchstatus.cpp \
+        engine.cpp \
+        gamelogic.cpp \
+        mappedfile.cpp \
+        mcts.cpp \
+        openingbook.cpp \
+        openingbook4x4.cpp \
+        perfectplay.cpp \
+        positionrank.cpp \
+        tablebase.cpp \
+        transpositiontable.cpp \
+        workstealingpool.cpp
+    HEADERS = \
+        bench_search.h
+}
+
+# Tablebase generator: qmake CONFIG+=tablebase
+CONFIG(tablebase) {
+    TEMPLATE = app
+    TARGET = TicTacToeTablebase
+    QT =
+    CONFIG += console
+    CONFIG -= app_bundle
+    INCLUDEPATH += .
+    SOURCES = \
+        tool_tablebase.cpp \
+        mappedfile.cpp \
+        positionrank.cpp \
+        tablebase.cpp
+    HEADERS = \
+        mappedfile.h \
+        positionrank.h \
+        stoptoken.h \
+        tablebase.h
+}
+
+# Opening book generator: qmake CONFIG+=openingbook
+CONFIG(openingbook) {
+    TEMPLATE = app
+    TARGET = TicTacToeBook
+    QT =
+    CONFIG += console
+    CONFIG -= app_bundle
+    INCLUDEPATH += .
+    SOURCES = \
+        tool_openingbook.cpp \
+        gamelogic.cpp \
+        mappedfile.cpp \
+        openingbook.cpp \
+        openingbook4x4.cpp \
+        perfectplay.cpp \
+        positionrank.cpp \
+        tablebase.cpp \
+        transpositiontable.cpp \
+        workstealingpool.cpp
+    HEADERS = \
+        gamelogic.h \
+        mappedfile.h \
+        openingbook.h \
+        stoptoken.h
 }
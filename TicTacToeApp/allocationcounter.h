@@ -0,0 +1,12 @@
+// allocationcounter.h
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+// Number of global operator new calls so far. allocationcounter.cpp
+// replaces the global allocation functions, so it is only linked into the
+// test build.
+std::uint64_t allocationCount();
+
+#endif // ALLOCATIONCOUNTER_H
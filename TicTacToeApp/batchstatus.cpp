@@ -0,0 +1,248 @@
+// batchstatus.cpp
+#include "batchstatus.h"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BATCH_STATUS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang compile each kernel for its own instruction set, so the
+// rest of the program still runs on any x86 CPU; MSVC needs no marking
+#if defined(__GNUC__)
+#define TARGET_ISA(isa) __attribute__((target(isa)))
+#else
+#define TARGET_ISA(isa)
+#endif
+
+// The kernels store results as 32-bit lanes
+static_assert(sizeof(GameResult) == sizeof(std::int32_t), "GameResult must be 32 bits wide");
+
+namespace {
+
+// One board at a time, as GameLogic::evaluateBoard() does it
+template <int N, int K>
+GameResult statusOf(const typename BoardGeometry<N, K>::Board &board)
+{
+    typedef BoardGeometry<N, K> Geometry;
+    bool open = false;
+    for (typename Geometry::Mask line : Geometry::LINES) {
+        if ((board.x & line) == line) {
+            return PLAYER_X_WINS;
+        }
+        if ((board.o & line) == line) {
+            return PLAYER_O_WINS;
+        }
+        open = open || !(board.x & line) || !(board.o & line);
+    }
+    return open ? GAME_ONGOING : GAME_DRAW;
+}
+
+#ifdef BATCH_STATUS_X86
+
+// Each kernel handles whole vectors and returns how many boards that
+// covered; the caller finishes the rest one by one. The X and O masks are
+// split into one 32-bit lane per board. The lines are then tested last to
+// first, X after O, so the first winning line, and X on a shared line,
+// overwrite the result last. A board where no line is free of either
+// side's marks starts out as a draw.
+
+template <int N, int K>
+TARGET_ISA("sse4.2")
+std::size_t statusSse42(const typename BoardGeometry<N, K>::Board *boards, GameResult *results, std::size_t count)
+{
+    typedef BoardGeometry<N, K> Geometry;
+    const int LANES = 4;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ongoing = _mm_set1_epi32(GAME_ONGOING);
+    const __m128i draw = _mm_set1_epi32(GAME_DRAW);
+    const __m128i xWins = _mm_set1_epi32(PLAYER_X_WINS);
+    const __m128i oWins = _mm_set1_epi32(PLAYER_O_WINS);
+
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        __m128i x, o;
+        if (sizeof(typename Geometry::Mask) == 2) {
+            __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i *>(boards + i));
+            x = _mm_and_si128(packed, _mm_set1_epi32(0xffff));
+            o = _mm_srli_epi32(packed, 16);
+        } else {
+            __m128 low = _mm_loadu_ps(reinterpret_cast<const float *>(boards + i));
+            __m128 high = _mm_loadu_ps(reinterpret_cast<const float *>(boards + i + 2));
+            x = _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+            o = _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+
+        __m128i open = zero;
+        for (int line = 0; line < Geometry::LINE_COUNT; ++line) {
+            __m128i mask = _mm_set1_epi32(Geometry::LINES[line]);
+            open = _mm_or_si128(open, _mm_cmpeq_epi32(_mm_and_si128(x, mask), zero));
+            open = _mm_or_si128(open, _mm_cmpeq_epi32(_mm_and_si128(o, mask), zero));
+        }
+        __m128i result = _mm_blendv_epi8(draw, ongoing, open);
+        for (int line = Geometry::LINE_COUNT - 1; line >= 0; --line) {
+            __m128i mask = _mm_set1_epi32(Geometry::LINES[line]);
+            result = _mm_blendv_epi8(result, oWins, _mm_cmpeq_epi32(_mm_and_si128(o, mask), mask));
+            result = _mm_blendv_epi8(result, xWins, _mm_cmpeq_epi32(_mm_and_si128(x, mask), mask));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(results + i), result);
+    }
+    return i;
+}
+
+template <int N, int K>
+TARGET_ISA("avx2")
+std::size_t statusAvx2(const typename BoardGeometry<N, K>::Board *boards, GameResult *results, std::size_t count)
+{
+    typedef BoardGeometry<N, K> Geometry;
+    const int LANES = 8;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ongoing = _mm256_set1_epi32(GAME_ONGOING);
+    const __m256i draw = _mm256_set1_epi32(GAME_DRAW);
+    const __m256i xWins = _mm256_set1_epi32(PLAYER_X_WINS);
+    const __m256i oWins = _mm256_set1_epi32(PLAYER_O_WINS);
+
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        __m256i x, o;
+        if (sizeof(typename Geometry::Mask) == 2) {
+            __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(boards + i));
+            x = _mm256_and_si256(packed, _mm256_set1_epi32(0xffff));
+            o = _mm256_srli_epi32(packed, 16);
+        } else {
+            // The shuffle works within 128-bit halves, leaving boards in
+            // the order 0 1 4 5 2 3 6 7 until the permute
+            __m256 low = _mm256_loadu_ps(reinterpret_cast<const float *>(boards + i));
+            __m256 high = _mm256_loadu_ps(reinterpret_cast<const float *>(boards + i + 4));
+            x = _mm256_castps_si256(_mm256_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+            o = _mm256_castps_si256(_mm256_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+            x = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 1, 2, 0));
+            o = _mm256_permute4x64_epi64(o, _MM_SHUFFLE(3, 1, 2, 0));
+        }
+
+        __m256i open = zero;
+        for (int line = 0; line < Geometry::LINE_COUNT; ++line) {
+            __m256i mask = _mm256_set1_epi32(Geometry::LINES[line]);
+            open = _mm256_or_si256(open, _mm256_cmpeq_epi32(_mm256_and_si256(x, mask), zero));
+            open = _mm256_or_si256(open, _mm256_cmpeq_epi32(_mm256_and_si256(o, mask), zero));
+        }
+        __m256i result = _mm256_blendv_epi8(draw, ongoing, open);
+        for (int line = Geometry::LINE_COUNT - 1; line >= 0; --line) {
+            __m256i mask = _mm256_set1_epi32(Geometry::LINES[line]);
+            result = _mm256_blendv_epi8(result, oWins, _mm256_cmpeq_epi32(_mm256_and_si256(o, mask), mask));
+            result = _mm256_blendv_epi8(result, xWins, _mm256_cmpeq_epi32(_mm256_and_si256(x, mask), mask));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(results + i), result);
+    }
+    return i;
+}
+
+template <int N, int K>
+TARGET_ISA("avx512f")
+std::size_t statusAvx512(const typename BoardGeometry<N, K>::Board *boards, GameResult *results, std::size_t count)
+{
+    typedef BoardGeometry<N, K> Geometry;
+    const int LANES = 16;
+    const __m512i ongoing = _mm512_set1_epi32(GAME_ONGOING);
+    const __m512i draw = _mm512_set1_epi32(GAME_DRAW);
+    const __m512i xWins = _mm512_set1_epi32(PLAYER_X_WINS);
+    const __m512i oWins = _mm512_set1_epi32(PLAYER_O_WINS);
+    const __m512i evenWords = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i oddWords = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        __m512i x, o;
+        if (sizeof(typename Geometry::Mask) == 2) {
+            __m512i packed = _mm512_loadu_si512(boards + i);
+            x = _mm512_and_si512(packed, _mm512_set1_epi32(0xffff));
+            o = _mm512_srli_epi32(packed, 16);
+        } else {
+            __m512i low = _mm512_loadu_si512(boards + i);
+            __m512i high = _mm512_loadu_si512(boards + i + 8);
+            x = _mm512_permutex2var_epi32(low, evenWords, high);
+            o = _mm512_permutex2var_epi32(low, oddWords, high);
+        }
+
+        __mmask16 open = 0;
+        for (int line = 0; line < Geometry::LINE_COUNT; ++line) {
+            __m512i mask = _mm512_set1_epi32(Geometry::LINES[line]);
+            open |= _mm512_testn_epi32_mask(x, mask) | _mm512_testn_epi32_mask(o, mask);
+        }
+        __m512i result = _mm512_mask_blend_epi32(open, draw, ongoing);
+        for (int line = Geometry::LINE_COUNT - 1; line >= 0; --line) {
+            __m512i mask = _mm512_set1_epi32(Geometry::LINES[line]);
+            result = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(_mm512_and_si512(o, mask), mask), result, oWins);
+            result = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(_mm512_and_si512(x, mask), mask), result, xWins);
+        }
+        _mm512_storeu_si512(results + i, result);
+    }
+    return i;
+}
+
+SimdLevel querySimdLevel()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    // The OS must also save the wider registers on a context switch
+    int info[4];
+    __cpuid(info, 1);
+    bool sse42 = (info[2] & (1 << 20)) != 0;
+    unsigned long long xcr0 = (info[2] & (1 << 27)) ? _xgetbv(0) : 0;
+    __cpuidex(info, 7, 0);
+    if ((info[1] & (1 << 16)) && (xcr0 & 0xe6) == 0xe6) return SIMD_AVX512;
+    if ((info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6) return SIMD_AVX2;
+    return sse42 ? SIMD_SSE42 : SIMD_SCALAR;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return SIMD_SSE42;
+    return SIMD_SCALAR;
+#endif
+}
+
+#else
+
+SimdLevel querySimdLevel()
+{
+    return SIMD_SCALAR;
+}
+
+#endif // BATCH_STATUS_X86
+
+} // namespace
+
+SimdLevel detectSimdLevel()
+{
+    static const SimdLevel level = querySimdLevel();
+    return level;
+}
+
+template <int N, int K>
+void checkGameStatusBatch(const typename BoardGeometry<N, K>::Board *boards, GameResult *results,
+                          std::size_t count, SimdLevel level)
+{
+    level = std::min(level, detectSimdLevel());
+
+    std::size_t done = 0;
+#ifdef BATCH_STATUS_X86
+    if (level == SIMD_AVX512) {
+        done = statusAvx512<N, K>(boards, results, count);
+    } else if (level == SIMD_AVX2) {
+        done = statusAvx2<N, K>(boards, results, count);
+    } else if (level == SIMD_SSE42) {
+        done = statusSse42<N, K>(boards, results, count);
+    }
+#endif
+    for (; done < count; ++done) {
+        results[done] = statusOf<N, K>(boards[done]);
+    }
+}
+
+template void checkGameStatusBatch<3, 3>(const BoardGeometry<3, 3>::Board *, GameResult *, std::size_t, SimdLevel);
+template void checkGameStatusBatch<4, 4>(const BoardGeometry<4, 4>::Board *, GameResult *, std::size_t, SimdLevel);
+template void checkGameStatusBatch<5, 4>(const BoardGeometry<5, 4>::Board *, GameResult *, std::size_t, SimdLevel);
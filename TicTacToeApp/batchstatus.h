@@ -0,0 +1,32 @@
+// batchstatus.h
+#ifndef BATCHSTATUS_H
+#define BATCHSTATUS_H
+
+#include <cstddef>
+#include "gamelogic.h"
+
+// Instruction sets the batch status check can use, slowest first
+enum SimdLevel { SIMD_SCALAR, SIMD_SSE42, SIMD_AVX2, SIMD_AVX512 };
+
+// Best level this CPU supports; checked once
+SimdLevel detectSimdLevel();
+
+// Writes the status of boards[i] to results[i], with the same answer as
+// GameLogic::checkGameStatus() for a game that reached that board: the
+// first winning line in Geometry::LINES order decides, X before O, and a
+// board where every line holds both sides' marks is drawn. Boards are
+// tested several per instruction, 4 (SSE4.2), 8 (AVX2) or 16 (AVX-512) at
+// a time. A level above what the CPU supports falls back to the best one
+// it does.
+template <int N, int K>
+void checkGameStatusBatch(const typename BoardGeometry<N, K>::Board *boards, GameResult *results,
+                          std::size_t count, SimdLevel level = detectSimdLevel());
+
+extern template void checkGameStatusBatch<3, 3>(const BoardGeometry<3, 3>::Board *, GameResult *,
+                                                std::size_t, SimdLevel);
+extern template void checkGameStatusBatch<4, 4>(const BoardGeometry<4, 4>::Board *, GameResult *,
+                                                std::size_t, SimdLevel);
+extern template void checkGameStatusBatch<5, 4>(const BoardGeometry<5, 4>::Board *, GameResult *,
+                                                std::size_t, SimdLevel);
+
+#endif // BATCHSTATUS_H
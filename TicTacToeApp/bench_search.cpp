@@ -0,0 +1,298 @@
+#include <QtTest/QTest>
+#include <QDebug>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include "batchstatus.h"
+#include "bench_search.h"
+#include "bitsliced.h"
+#include "mcts.h"
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+const char *const SIMD_LEVEL_NAMES[] = { "scalar", "SSE4.2", "AVX2", "AVX-512" };
+
+// Boards per second of checkGameStatusBatch() at each level, over a
+// cache-sized batch of random boards
+template <int N, int K>
+void reportBatchLevels(const char *name) {
+    typedef typename BoardGeometry<N, K>::Board Board;
+    std::mt19937 random(N);
+    std::vector<Board> boards(1 << 14);
+    for (Board &board : boards) {
+        board.x = 0;
+        board.o = 0;
+        for (int cell = 0; cell < N * N; ++cell) {
+            int mark = random() % 3;
+            if (mark == 1) board.x |= BoardGeometry<N, K>::bit(cell);
+            if (mark == 2) board.o |= BoardGeometry<N, K>::bit(cell);
+        }
+    }
+    std::vector<GameResult> results(boards.size());
+
+    for (int level = SIMD_SCALAR; level <= detectSimdLevel(); ++level) {
+        std::uint64_t checked = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (secondsSince(start) < 0.25) {
+            for (int pass = 0; pass < 16; ++pass) {
+                checkGameStatusBatch<N, K>(boards.data(), results.data(), boards.size(), SimdLevel(level));
+            }
+            checked += 16 * boards.size();
+        }
+        qInfo() << name << SIMD_LEVEL_NAMES[level] << "boards/s" << qint64(checked / secondsSince(start));
+    }
+}
+
+// Positions per second of evaluateSliced() over every 3x3 encoding, with
+// the planes built beforehand as an enumeration job would
+template <int Words>
+void reportSlicedWords() {
+    const int POSITIONS = 19683;
+    const int LANES = SlicedBoards<3, 3, Words>::LANES;
+    std::vector<GameLogic::Board> boards(POSITIONS);
+    for (int rank = 0; rank < POSITIONS; ++rank) {
+        boards[rank] = { 0, 0 };
+        for (int cell = 0, r = rank; cell < 9; ++cell, r /= 3) {
+            if (r % 3 == 1) boards[rank].x |= GameLogic::Geometry::bit(cell);
+            if (r % 3 == 2) boards[rank].o |= GameLogic::Geometry::bit(cell);
+        }
+    }
+    std::vector<SlicedBoards<3, 3, Words>> planes((POSITIONS + LANES - 1) / LANES);
+    for (std::size_t i = 0; i < planes.size(); ++i) {
+        sliceBoards(boards.data() + i * LANES, std::min<std::size_t>(LANES, POSITIONS - i * LANES), planes[i]);
+    }
+
+    std::uint64_t checked = 0;
+    std::uint64_t wins = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (secondsSince(start) < 0.25) {
+        for (const SlicedBoards<3, 3, Words> &group : planes) {
+            SlicedStatus<Words> status;
+            evaluateSliced(group, status);
+            for (int w = 0; w < Words; ++w) {
+                wins += bitCount(status.xWins[w]);
+            }
+        }
+        checked += planes.size() * LANES;
+    }
+    qInfo() << "3x3" << LANES << "lanes positions/s" << qint64(checked / secondsSince(start))
+            << "X wins seen" << qint64(wins);
+}
+
+const char *const SEARCH_WINDOW_NAMES[] = { "alpha-beta", "PVS", "PVS + aspiration" };
+const char *const MOVE_ORDERING_NAMES[] = { "cell order", "killers + history" };
+
+// Random unfinished openings with marks cells taken, the same every run
+template <int N, int K>
+std::vector<std::vector<int>> randomOpenings(int marks, int count) {
+    typedef BasicGameLogic<N, K> Game;
+    std::mt19937 random(N * 100 + marks);
+    std::vector<std::vector<int>> openings;
+    while (int(openings.size()) < count) {
+        Game game;
+        std::vector<int> opening;
+        while (int(opening.size()) < marks && game.checkGameStatus() == GAME_ONGOING) {
+            int move = random() % Game::CELL_COUNT;
+            if (game.makeMove(move)) {
+                opening.push_back(move);
+            }
+        }
+        if (game.checkGameStatus() == GAME_ONGOING) {
+            openings.push_back(opening);
+        }
+    }
+    return openings;
+}
+
+// Mean nodes per move of each window mode over the same random openings,
+// each searched by a fresh game within limits
+template <int N, int K>
+void reportWindowNodes(const char *name, int marks, const SearchLimits &limits) {
+    typedef BasicGameLogic<N, K> Game;
+    const int POSITIONS = 16;
+    std::vector<std::vector<int>> openings = randomOpenings<N, K>(marks, POSITIONS);
+
+    double fullNodes = 0;
+    for (int mode = WINDOWS_FULL; mode <= WINDOWS_ASPIRATION; ++mode) {
+        std::uint64_t nodes = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const std::vector<int> &opening : openings) {
+            Game game;
+            game.setSearchWindows(SearchWindows(mode));
+            game.setSearchLimits(limits);
+            for (int move : opening) {
+                game.makeMove(move);
+            }
+            nodes += game.search().nodes;
+        }
+        double perMove = double(nodes) / POSITIONS;
+        if (mode == WINDOWS_FULL) {
+            fullNodes = perMove;
+        }
+        qInfo() << name << marks << "marks" << SEARCH_WINDOW_NAMES[mode] << "nodes/move" << qint64(perMove)
+                << "of alpha-beta" << perMove / fullNodes << "in" << secondsSince(start) << "s";
+    }
+}
+
+// Nodes per move and how often a cutoff came from the first move tried,
+// per move ordering, over the same random openings
+template <int N, int K>
+void reportOrdering(const char *name, int marks, const SearchLimits &limits) {
+    typedef BasicGameLogic<N, K> Game;
+    const int POSITIONS = 16;
+    std::vector<std::vector<int>> openings = randomOpenings<N, K>(marks, POSITIONS);
+
+    for (int ordering = ORDERING_CELLS; ordering <= ORDERING_HISTORY; ++ordering) {
+        std::uint64_t nodes = 0;
+        std::uint64_t cutoffs = 0;
+        std::uint64_t firstMoveCutoffs = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const std::vector<int> &opening : openings) {
+            Game game;
+            game.setMoveOrdering(MoveOrdering(ordering));
+            game.setSearchLimits(limits);
+            for (int move : opening) {
+                game.makeMove(move);
+            }
+            nodes += game.search().nodes;
+            for (const ThreadStats &thread : game.getThreadStats()) {
+                cutoffs += thread.cutoffs;
+                firstMoveCutoffs += thread.firstMoveCutoffs;
+            }
+        }
+        qInfo() << name << marks << "marks" << MOVE_ORDERING_NAMES[ordering]
+                << "nodes/move" << qint64(nodes / POSITIONS)
+                << "first-move cutoffs" << double(firstMoveCutoffs) / std::max<std::uint64_t>(cutoffs, 1)
+                << "in" << secondsSince(start) << "s";
+    }
+}
+
+} // namespace
+
+void BenchSearch::benchmarkSolve3x3() {
+    // Full minimax from the empty board
+    QBENCHMARK {
+        GameLogic game;
+        game.getBestMoveBySearch();
+    }
+}
+
+void BenchSearch::benchmarkFixedDepth5x5() {
+    // Six plies of the empty 5x5 board, one thread
+    SearchLimits limits = { 6, 0, 0 };
+    QBENCHMARK {
+        GameLogic5x5 game;
+        game.setSearchLimits(limits);
+        game.search();
+    }
+}
+
+void BenchSearch::reportThreadScaling() {
+    // Nodes per second and time to reach a fixed depth, per thread count
+    const int threadCounts[] = { 1, 2, 4, 8, 16 };
+    const ParallelMode modes[] = { PARALLEL_LAZY_SMP, PARALLEL_YOUNG_BROTHERS };
+    SearchLimits timed = { 0, 1000, 0 };
+    SearchLimits fixedDepth = { 8, 0, 0 };
+
+    qInfo() << "Scaling on empty 5x5, hardware threads:" << std::thread::hardware_concurrency();
+    for (ParallelMode mode : modes) {
+        double baseRate = 0;
+        double baseTime = 0;
+        qInfo() << (mode == PARALLEL_LAZY_SMP ? "Lazy SMP" : "Young Brothers Wait");
+        for (int threads : threadCounts) {
+            GameLogic5x5 game;
+            game.setThreadCount(threads);
+            game.setParallelMode(mode);
+            game.setSearchLimits(timed);
+            auto start = std::chrono::steady_clock::now();
+            SearchResult result = game.search();
+            double rate = result.nodes / secondsSince(start);
+
+            GameLogic5x5 depthGame;
+            depthGame.setThreadCount(threads);
+            depthGame.setParallelMode(mode);
+            depthGame.setSearchLimits(fixedDepth);
+            start = std::chrono::steady_clock::now();
+            depthGame.search();
+            double depthTime = secondsSince(start);
+
+            if (threads == 1) {
+                baseRate = rate;
+                baseTime = depthTime;
+            }
+            qInfo() << "threads" << threads
+                    << "nodes/s" << qint64(rate) << "scaling" << rate / baseRate
+                    << "depth" << fixedDepth.maxDepth << "in" << depthTime << "s speedup" << baseTime / depthTime;
+
+            // How evenly the work was spread, from the fixed-depth run
+            for (const ThreadStats &thread : depthGame.getThreadStats()) {
+                qInfo() << "    nodes" << qint64(thread.nodes)
+                        << "tasks" << qint64(thread.tasks) << "steals" << qint64(thread.steals);
+            }
+        }
+    }
+}
+
+void BenchSearch::reportSearchWindows() {
+    // 4x4 solved to the end, 5x5 to a fixed depth
+    SearchLimits solve = { 0, 0, 0 };
+    SearchLimits fixedDepth = { 7, 0, 0 };
+    reportWindowNodes<4, 4>("4x4", 4, solve);
+    reportWindowNodes<4, 4>("4x4", 6, solve);
+    reportWindowNodes<5, 4>("5x5", 1, fixedDepth);
+    reportWindowNodes<5, 4>("5x5", 4, fixedDepth);
+}
+
+void BenchSearch::reportMoveOrdering() {
+    // 4x4 solved to the end, 5x5 to a fixed depth
+    SearchLimits solve = { 0, 0, 0 };
+    SearchLimits fixedDepth = { 8, 0, 0 };
+    reportOrdering<4, 4>("4x4", 4, solve);
+    reportOrdering<4, 4>("4x4", 6, solve);
+    reportOrdering<5, 4>("5x5", 1, fixedDepth);
+    reportOrdering<5, 4>("5x5", 4, fixedDepth);
+}
+
+void BenchSearch::reportMctsPlayouts() {
+    // Playouts per second on empty 5x5, per thread count
+    const int threadCounts[] = { 1, 2, 4, 8, 16 };
+    SearchLimits timed = { 0, 1000, 0 };
+    GameLogic5x5 game;
+
+    qInfo() << "MCTS playouts on empty 5x5";
+    for (int threads : threadCounts) {
+        BasicMctsEngine<5, 4> engine;
+        engine.setThreadCount(threads);
+        engine.setSearchLimits(timed);
+        SearchResult result = engine.search(game, StopToken());
+        const MctsStats &stats = engine.getStats();
+        qInfo() << "threads" << threads << "playouts/s" << qint64(stats.playoutsPerSecond)
+                << "tree nodes" << qint64(stats.treeNodes) << "depth" << stats.treeDepth
+                << "move" << result.move;
+    }
+}
+
+void BenchSearch::reportBatchStatus() {
+    qInfo() << "Batch status, best level on this CPU:" << SIMD_LEVEL_NAMES[detectSimdLevel()];
+    reportBatchLevels<3, 3>("3x3");
+    reportBatchLevels<4, 4>("4x4");
+    reportBatchLevels<5, 4>("5x5");
+}
+
+void BenchSearch::reportBitSliced() {
+    reportSlicedWords<1>();
+    reportSlicedWords<4>();
+    reportSlicedWords<8>();
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    BenchSearch benchSearch;
+    return QTest::qExec(&benchSearch, argc, argv);
+}
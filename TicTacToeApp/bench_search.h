@@ -0,0 +1,20 @@
+#ifndef BENCHSEARCH_H
+#define BENCHSEARCH_H
+
+#include <QObject>
+#include "gamelogic.h"
+
+class BenchSearch : public QObject {
+    Q_OBJECT
+private slots:
+    void benchmarkSolve3x3();
+    void benchmarkFixedDepth5x5();
+    void reportThreadScaling();
+    void reportSearchWindows();
+    void reportMoveOrdering();
+    void reportMctsPlayouts();
+    void reportBatchStatus();
+    void reportBitSliced();
+};
+
+#endif // BENCHSEARCH_H
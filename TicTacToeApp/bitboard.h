@@ -0,0 +1,191 @@
+// bitboard.h
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// One bit per cell (bit i = cell i, row by row), one mask per side
+template <typename Mask>
+struct BasicBitboard
+{
+    Mask x;
+    Mask o;
+};
+
+// Smallest unsigned type with one bit per cell
+template <int Cells>
+using MaskFor = std::conditional_t<(Cells <= 16), std::uint16_t,
+                std::conditional_t<(Cells <= 32), std::uint32_t, std::uint64_t>>;
+
+constexpr int winningLineCount(int n, int k)
+{
+    return 2 * n * (n - k + 1) + 2 * (n - k + 1) * (n - k + 1);
+}
+
+// Every run of K cells in a row, column, diagonal and anti-diagonal; on
+// 3x3 this is rows, columns, then the two diagonals
+template <int N, int K, typename Mask>
+constexpr std::array<Mask, winningLineCount(N, K)> makeWinningLines()
+{
+    std::array<Mask, winningLineCount(N, K)> lines {};
+    int count = 0;
+    const int directions[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+
+    for (const auto &direction : directions) {
+        int dr = direction[0];
+        int dc = direction[1];
+        for (int row = 0; row < N; ++row) {
+            for (int col = 0; col < N; ++col) {
+                int lastRow = row + dr * (K - 1);
+                int lastCol = col + dc * (K - 1);
+                if (lastRow < 0 || lastRow >= N || lastCol < 0 || lastCol >= N) {
+                    continue;
+                }
+                Mask line = 0;
+                for (int i = 0; i < K; ++i) {
+                    line |= Mask(Mask(1) << ((row + dr * i) * N + col + dc * i));
+                }
+                lines[count++] = line;
+            }
+        }
+    }
+    return lines;
+}
+
+// The winning lines through one cell; at most K per direction
+template <typename Mask, int MaxLines>
+struct CellLines
+{
+    int count;
+    std::array<Mask, MaxLines> lines;
+};
+
+template <int N, int K, typename Mask>
+constexpr std::array<CellLines<Mask, 4 * K>, N * N> makeCellLines()
+{
+    std::array<CellLines<Mask, 4 * K>, N * N> cells {};
+    for (Mask line : makeWinningLines<N, K, Mask>()) {
+        for (int cell = 0; cell < N * N; ++cell) {
+            if (line & Mask(Mask(1) << cell)) {
+                cells[cell].lines[cells[cell].count++] = line;
+            }
+        }
+    }
+    return cells;
+}
+
+// A set of winning lines, bit i standing for LINES[i]
+template <int LineCount>
+using LineSetFor = std::conditional_t<(LineCount <= 32), std::uint32_t, std::uint64_t>;
+
+// The winning lines through each cell, as line sets
+template <int N, int K, typename Mask>
+constexpr std::array<LineSetFor<winningLineCount(N, K)>, N * N> makeCellLineSets()
+{
+    typedef LineSetFor<winningLineCount(N, K)> LineSet;
+    std::array<LineSet, N * N> cells {};
+    std::array<Mask, winningLineCount(N, K)> lines = makeWinningLines<N, K, Mask>();
+    for (int i = 0; i < winningLineCount(N, K); ++i) {
+        for (int cell = 0; cell < N * N; ++cell) {
+            if (lines[i] & Mask(Mask(1) << cell)) {
+                cells[cell] |= LineSet(LineSet(1) << i);
+            }
+        }
+    }
+    return cells;
+}
+
+// Compile-time description of an N x N board where K in a row wins
+template <int N, int K>
+struct BoardGeometry
+{
+    static_assert(K >= 3 && K <= N && N * N <= 64 && winningLineCount(N, K) <= 64, "unsupported board geometry");
+
+    typedef MaskFor<N * N> Mask;
+    typedef BasicBitboard<Mask> Board;
+    typedef LineSetFor<winningLineCount(N, K)> LineSet;
+
+    static constexpr int CELLS = N * N;
+    static constexpr int LINE_COUNT = winningLineCount(N, K);
+    static constexpr Mask FULL = Mask(~0ull >> (64 - CELLS));
+    static constexpr std::array<Mask, LINE_COUNT> LINES = makeWinningLines<N, K, Mask>();
+    static constexpr std::array<CellLines<Mask, 4 * K>, CELLS> CELL_LINES = makeCellLines<N, K, Mask>();
+    static constexpr LineSet ALL_LINES = LineSet(~0ull >> (64 - LINE_COUNT));
+    static constexpr std::array<LineSet, CELLS> CELL_LINE_SETS = makeCellLineSets<N, K, Mask>();
+
+    static constexpr Mask bit(int cell)
+    {
+        return Mask(Mask(1) << cell);
+    }
+
+    static Mask emptyCells(const Board &board)
+    {
+        return FULL & ~(board.x | board.o);
+    }
+
+    // Lines side (0 for X, 1 for O) can still complete: those free of the
+    // other side's marks
+    static LineSet openLines(const Board &board, int side)
+    {
+        Mask other = side ? board.x : board.o;
+        LineSet open = 0;
+        for (int i = 0; i < LINE_COUNT; ++i) {
+            if (!(other & LINES[i])) {
+                open |= LineSet(LineSet(1) << i);
+            }
+        }
+        return open;
+    }
+
+    // Only lines through the last mark placed can have been completed by it
+    static bool completesLine(Mask marks, int cell)
+    {
+        const CellLines<Mask, 4 * K> &through = CELL_LINES[cell];
+        for (int i = 0; i < through.count; ++i) {
+            if ((marks & through.lines[i]) == through.lines[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Index of the lowest set bit; mask must not be zero
+template <typename Mask>
+inline int lowestBit(Mask mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+template <typename Mask>
+inline int bitCount(Mask mask)
+{
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(mask));
+#else
+    return __builtin_popcountll(mask);
+#endif
+}
+
+// Removes the lowest set bit from mask and returns its index
+template <typename Mask>
+inline int popLowestBit(Mask &mask)
+{
+    int index = lowestBit(mask);
+    mask &= mask - 1;
+    return index;
+}
+
+#endif // BITBOARD_H
@@ -0,0 +1,131 @@
+// bitsliced.h
+#ifndef BITSLICED_H
+#define BITSLICED_H
+
+#include <cstddef>
+#include <cstdint>
+#include "gamelogic.h"
+
+// Many positions stored one bit each: bit j of word w in x[cell] is set
+// when position 64 * w + j has an X on cell. A winning line is then the
+// AND of its cells' planes, for every position at once. Words of 4 or 8
+// are laid out so the compiler can use 256- or 512-bit registers where the
+// build allows them.
+template <int N, int K, int Words = 1>
+struct SlicedBoards
+{
+    static constexpr int LANES = 64 * Words;
+
+    std::uint64_t x[N * N][Words];
+    std::uint64_t o[N * N][Words];
+};
+
+// One bit per position; a position in none of the three is still ongoing
+template <int Words = 1>
+struct SlicedStatus
+{
+    std::uint64_t xWins[Words];
+    std::uint64_t oWins[Words];
+    std::uint64_t draw[Words];
+};
+
+// Same answers as GameLogic::checkGameStatus(): the first winning line in
+// Geometry::LINES order decides, X before O on the same line, and a
+// position is drawn once every line holds marks of both sides
+template <int N, int K, int Words>
+void evaluateSliced(const SlicedBoards<N, K, Words> &boards, SlicedStatus<Words> &status)
+{
+    typedef BoardGeometry<N, K> Geometry;
+
+    std::uint64_t decided[Words] = {};
+    std::uint64_t open[Words] = {}; // Some line is free of X's or of O's marks
+    for (int w = 0; w < Words; ++w) {
+        status.xWins[w] = 0;
+        status.oWins[w] = 0;
+    }
+
+    for (typename Geometry::Mask line : Geometry::LINES) {
+        std::uint64_t xLine[Words], oLine[Words], xAny[Words], oAny[Words];
+        for (int w = 0; w < Words; ++w) {
+            xLine[w] = ~0ull;
+            oLine[w] = ~0ull;
+            xAny[w] = 0;
+            oAny[w] = 0;
+        }
+        for (typename Geometry::Mask cells = line; cells;) {
+            int cell = popLowestBit(cells);
+            for (int w = 0; w < Words; ++w) {
+                xLine[w] &= boards.x[cell][w];
+                oLine[w] &= boards.o[cell][w];
+                xAny[w] |= boards.x[cell][w];
+                oAny[w] |= boards.o[cell][w];
+            }
+        }
+        for (int w = 0; w < Words; ++w) {
+            open[w] |= ~(xAny[w] & oAny[w]);
+            std::uint64_t xNew = xLine[w] & ~decided[w];
+            std::uint64_t oNew = oLine[w] & ~(decided[w] | xNew);
+            status.xWins[w] |= xNew;
+            status.oWins[w] |= oNew;
+            decided[w] |= xNew | oNew;
+        }
+    }
+
+    for (int w = 0; w < Words; ++w) {
+        status.draw[w] = ~(open[w] | decided[w]);
+    }
+}
+
+// Transposes up to LANES packed boards into planes; unused lanes are empty
+template <int N, int K, int Words>
+void sliceBoards(const typename BoardGeometry<N, K>::Board *boards, std::size_t count,
+                 SlicedBoards<N, K, Words> &sliced)
+{
+    for (int cell = 0; cell < N * N; ++cell) {
+        for (int w = 0; w < Words; ++w) {
+            sliced.x[cell][w] = 0;
+            sliced.o[cell][w] = 0;
+        }
+    }
+    for (std::size_t j = 0; j < count; ++j) {
+        std::uint64_t bit = 1ull << (j % 64);
+        for (typename BoardGeometry<N, K>::Mask x = boards[j].x; x;) {
+            sliced.x[popLowestBit(x)][j / 64] |= bit;
+        }
+        for (typename BoardGeometry<N, K>::Mask o = boards[j].o; o;) {
+            sliced.o[popLowestBit(o)][j / 64] |= bit;
+        }
+    }
+}
+
+template <int Words>
+GameResult slicedResult(const SlicedStatus<Words> &status, std::size_t lane)
+{
+    std::uint64_t bit = 1ull << (lane % 64);
+    if (status.xWins[lane / 64] & bit) return PLAYER_X_WINS;
+    if (status.oWins[lane / 64] & bit) return PLAYER_O_WINS;
+    if (status.draw[lane / 64] & bit) return GAME_DRAW;
+    return GAME_ONGOING;
+}
+
+// Packed boards in, one result each out, LANES boards per evaluation.
+// Transposing costs more than evaluating, so jobs that can generate their
+// positions as planes should call evaluateSliced() directly.
+template <int N, int K, int Words = 1>
+void checkGameStatusSliced(const typename BoardGeometry<N, K>::Board *boards, GameResult *results,
+                           std::size_t count)
+{
+    const std::size_t LANES = SlicedBoards<N, K, Words>::LANES;
+    SlicedBoards<N, K, Words> sliced;
+    SlicedStatus<Words> status;
+    for (std::size_t first = 0; first < count; first += LANES) {
+        std::size_t lanes = count - first < LANES ? count - first : LANES;
+        sliceBoards(boards + first, lanes, sliced);
+        evaluateSliced(sliced, status);
+        for (std::size_t j = 0; j < lanes; ++j) {
+            results[first + j] = slicedResult(status, j);
+        }
+    }
+}
+
+#endif // BITSLICED_H
@@ -0,0 +1,35 @@
+// difficulty.h
+#ifndef DIFFICULTY_H
+#define DIFFICULTY_H
+
+#include "search.h"
+
+// Strengths the AI can play at. Every level has a time limit, so no AI
+// move takes longer than that whatever the board; the weaker levels also
+// stop early on depth and nodes, and misjudge quiet positions on purpose.
+enum Difficulty { DIFFICULTY_EASY, DIFFICULTY_MEDIUM, DIFFICULTY_HARD, DIFFICULTY_PERFECT };
+
+const int DIFFICULTY_COUNT = 4;
+
+struct DifficultySettings
+{
+    const char *name;
+    SearchLimits limits;    // For MCTS the node limit is the playout count
+    int evaluationNoise;    // Static scores are off by up to this much either way
+    bool solvedLookup;      // Answer from solved tables and the opening book without searching
+};
+
+inline DifficultySettings difficultySettings(Difficulty level)
+{
+    // Easy sees its own wins but not the human's, medium blocks them too,
+    // hard looks four plies ahead: far enough to see forks coming
+    static const DifficultySettings SETTINGS[DIFFICULTY_COUNT] = {
+        { "Easy", { 1, 50, 2000 }, 8, false },
+        { "Medium", { 2, 100, 20000 }, 3, false },
+        { "Hard", { 4, 250, 200000 }, 0, false },
+        { "Perfect", { 0, 2000, 0 }, 0, true }
+    };
+    return SETTINGS[level];
+}
+
+#endif // DIFFICULTY_H
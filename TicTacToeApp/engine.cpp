@@ -0,0 +1,61 @@
+// engine.cpp
+#include "engine.h"
+#include "mcts.h"
+
+template <int N, int K>
+EngineType BasicAlphaBetaEngine<N, K>::type() const
+{
+    return ENGINE_ALPHA_BETA;
+}
+
+template <int N, int K>
+void BasicAlphaBetaEngine<N, K>::setSearchLimits(const SearchLimits &limits)
+{
+    engine.setSearchLimits(limits);
+}
+
+template <int N, int K>
+void BasicAlphaBetaEngine<N, K>::setThreadCount(int threads)
+{
+    engine.setThreadCount(threads);
+}
+
+template <int N, int K>
+SearchResult BasicAlphaBetaEngine<N, K>::search(const Game &game, const StopToken &stop)
+{
+    engine.copyPosition(game);
+    return engine.search(stop);
+}
+
+template <int N, int K>
+void BasicAlphaBetaEngine<N, K>::setDifficulty(Difficulty level)
+{
+    DifficultySettings settings = difficultySettings(level);
+    engine.setSearchLimits(settings.limits);
+    engine.setEvaluationNoise(settings.evaluationNoise);
+    engine.setSolvedLookup(settings.solvedLookup);
+}
+
+template <int N, int K>
+int BasicAlphaBetaEngine<N, K>::bestMove(const Game &game, const StopToken &stop)
+{
+    engine.copyPosition(game);
+    return engine.getBestMove(stop);
+}
+
+template <int N, int K>
+std::unique_ptr<BasicEngine<N, K>> makeEngine(EngineType type)
+{
+    if (type == ENGINE_MCTS) {
+        return std::unique_ptr<BasicEngine<N, K>>(new BasicMctsEngine<N, K>());
+    }
+    return std::unique_ptr<BasicEngine<N, K>>(new BasicAlphaBetaEngine<N, K>());
+}
+
+template class BasicAlphaBetaEngine<3, 3>;
+template class BasicAlphaBetaEngine<4, 4>;
+template class BasicAlphaBetaEngine<5, 4>;
+
+template std::unique_ptr<BasicEngine<3, 3>> makeEngine<3, 3>(EngineType type);
+template std::unique_ptr<BasicEngine<4, 4>> makeEngine<4, 4>(EngineType type);
+template std::unique_ptr<BasicEngine<5, 4>> makeEngine<5, 4>(EngineType type);
@@ -0,0 +1,67 @@
+// engine.h
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <memory>
+#include "difficulty.h"
+#include "gamelogic.h"
+#include "search.h"
+#include "stoptoken.h"
+
+enum EngineType { ENGINE_ALPHA_BETA, ENGINE_MCTS };
+
+// Anything that can pick the side to move's move in a game. Engines keep
+// their own state (tables, trees) between calls, so one engine should
+// follow one game.
+template <int N, int K>
+class BasicEngine
+{
+public:
+    typedef BasicGameLogic<N, K> Game;
+
+    virtual ~BasicEngine() = default;
+
+    virtual EngineType type() const = 0;
+    virtual void setSearchLimits(const SearchLimits &limits) = 0;
+    virtual void setThreadCount(int threads) = 0;
+    virtual SearchResult search(const Game &game, const StopToken &stop) = 0;
+
+    // Engines without an evaluation or solved tables only take the limits
+    virtual void setDifficulty(Difficulty level)
+    {
+        setSearchLimits(difficultySettings(level).limits);
+    }
+
+    // Engines with a faster path than a full search override this
+    virtual int bestMove(const Game &game, const StopToken &stop)
+    {
+        return search(game, stop).move;
+    }
+};
+
+// The minimax search of BasicGameLogic, with its table kept between moves
+template <int N, int K>
+class BasicAlphaBetaEngine : public BasicEngine<N, K>
+{
+public:
+    typedef BasicGameLogic<N, K> Game;
+
+    EngineType type() const override;
+    void setSearchLimits(const SearchLimits &limits) override;
+    void setThreadCount(int threads) override;
+    SearchResult search(const Game &game, const StopToken &stop) override;
+    void setDifficulty(Difficulty level) override;
+    int bestMove(const Game &game, const StopToken &stop) override;
+
+private:
+    Game engine;
+};
+
+template <int N, int K>
+std::unique_ptr<BasicEngine<N, K>> makeEngine(EngineType type);
+
+extern template class BasicAlphaBetaEngine<3, 3>;
+extern template class BasicAlphaBetaEngine<4, 4>;
+extern template class BasicAlphaBetaEngine<5, 4>;
+
+#endif // ENGINE_H
@@ -0,0 +1,83 @@
+// evaluator.h
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "bitboard.h"
+
+// Static score of a position from O's point of view, used where a
+// depth-limited search stops before the end of the game. The search keeps
+// the score up to date with moveDelta() as it makes moves, and calls
+// evaluate() only at its root. A null evaluate means no evaluator: every
+// unfinished position at the horizon scores 0.
+template <typename Board>
+struct StaticEvaluator
+{
+    int (*evaluate)(const Board &board);
+    // Change of the score when side (0 for X, 1 for O) marks cell on board
+    int (*moveDelta)(const Board &board, int cell, int side);
+};
+
+// Open lines: a line that only one side has marks in is still winnable by
+// that side, and worth 3^(marks - 1) to it. Lines holding both sides' marks
+// are dead and worth nothing.
+template <int N, int K>
+struct OpenLinesEvaluator
+{
+    typedef BoardGeometry<N, K> Geometry;
+    typedef typename Geometry::Mask Mask;
+    typedef typename Geometry::Board Board;
+
+    static constexpr int lineWeight(int marks)
+    {
+        int weight = marks > 0 ? 1 : 0;
+        for (int i = 1; i < marks; ++i) {
+            weight *= 3;
+        }
+        return weight;
+    }
+
+    // O's view of a line holding x and o marks
+    static int lineScore(int x, int o)
+    {
+        if (x && o) {
+            return 0;
+        }
+        return lineWeight(o) - lineWeight(x);
+    }
+
+    static int lineScore(const Board &board, Mask line)
+    {
+        return lineScore(bitCount(Mask(board.x & line)), bitCount(Mask(board.o & line)));
+    }
+
+    static int evaluate(const Board &board)
+    {
+        int score = 0;
+        for (Mask line : Geometry::LINES) {
+            score += lineScore(board, line);
+        }
+        return score;
+    }
+
+    static int moveDelta(const Board &board, int cell, int side)
+    {
+        // Only the lines through cell change, each by one mark
+        int delta = 0;
+        const CellLines<Mask, 4 * K> &through = Geometry::CELL_LINES[cell];
+        for (int i = 0; i < through.count; ++i) {
+            int x = bitCount(Mask(board.x & through.lines[i]));
+            int o = bitCount(Mask(board.o & through.lines[i]));
+            int after = side ? lineScore(x, o + 1) : lineScore(x + 1, o);
+            delta += after - lineScore(x, o);
+        }
+        return delta;
+    }
+};
+
+template <int N, int K>
+StaticEvaluator<typename BoardGeometry<N, K>::Board> openLinesEvaluator()
+{
+    return { &OpenLinesEvaluator<N, K>::evaluate, &OpenLinesEvaluator<N, K>::moveDelta };
+}
+
+#endif // EVALUATOR_H
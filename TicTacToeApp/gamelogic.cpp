@@ -1,168 +1,1065 @@
-// gamelogic.cppp
+// gamelogic.cpp
 #include "gamelogic.h"
+#include "perfectplay.h"
 #include <algorithm>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <vector>
 
-GameLogic::GameLogic()
+namespace {
+
+// A win scores WIN_SCORE minus the plies it takes, so quicker wins (and
+// slower losses) are preferred on every board size
+const int WIN_SCORE = 1000;
+const int INFINITE_SCORE = 10000;
+
+// Static evaluations are clamped to this, well short of any win score
+const int HEURISTIC_LIMIT = WIN_SCORE / 2;
+
+// Young Brothers Wait only splits nodes with at least this many plies left
+const int SPLIT_MIN_DRAFT = 4;
+
+// History scores are halved when one passes this, keeping the newer
+// cutoffs ahead and the sort keys small
+const int HISTORY_LIMIT = 1 << 20;
+
+// Half-width of the first aspiration window. One more ply seldom moves
+// the score further; narrower windows fail often enough to cost more.
+const int ASPIRATION_WINDOW = 64;
+
+// Win scores are stored relative to the node they belong to, so an entry
+// stays valid when the same position turns up at a different depth
+int scoreToTable(int score, int depth)
+{
+    if (score > HEURISTIC_LIMIT) return score + depth;
+    if (score < -HEURISTIC_LIMIT) return score - depth;
+    return score;
+}
+
+int scoreFromTable(int score, int depth)
+{
+    if (score > HEURISTIC_LIMIT) return score - depth;
+    if (score < -HEURISTIC_LIMIT) return score + depth;
+    return score;
+}
+
+// Noise in [-amplitude, amplitude] for the position with canonical key,
+// drawn afresh for each seed
+int noiseFor(std::uint64_t key, std::uint64_t seed, int amplitude)
+{
+    std::uint64_t bits = (key ^ seed) * 0x9e3779b97f4a7c15ULL;
+    bits ^= bits >> 29;
+    return int(bits % std::uint64_t(2 * amplitude + 1)) - amplitude;
+}
+
+// Every game of one board shares the book compiled in for it
+template <int N, int K>
+std::shared_ptr<const BasicOpeningBook<N, K>> embeddedBook()
+{
+    static const std::shared_ptr<const BasicOpeningBook<N, K>> book = [] {
+        std::shared_ptr<BasicOpeningBook<N, K>> embedded = std::make_shared<BasicOpeningBook<N, K>>();
+        return embedded->loadEmbedded() ? embedded : nullptr;
+    }();
+    return book;
+}
+
+} // namespace
+
+template <int N, int K>
+BasicGameLogic<N, K>::BasicGameLogic()
+    : transpositionTable(N == 3 ? 1 << 14 : 1 << 20), tableStats(), threadCount(1),
+      parallelMode(PARALLEL_LAZY_SMP), activePool(nullptr), evaluator(openLinesEvaluator<N, K>()),
+      openingBook(embeddedBook<N, K>()), solvedLookup(true), evaluationNoise(0), noiseSeed(0),
+      searchLimits(), searchWindows(WINDOWS_ASPIRATION), moveOrdering(ORDERING_HISTORY), activeLimits()
 {
     resetGame();
 }
 
-void GameLogic::resetGame()
+template <int N, int K>
+void BasicGameLogic<N, K>::resetGame()
 {
-    board.clear();
-    board.resize(9, CELL_EMPTY);
+    board.x = 0;
+    board.o = 0;
+    resetHash(hash);
     currentPlayer = PLAYER_X;
+    status = GAME_ONGOING;
+    openLines[0] = Geometry::ALL_LINES;
+    openLines[1] = Geometry::ALL_LINES;
 }
 
-bool GameLogic::makeMove(int cellIndex)
+template <int N, int K>
+bool BasicGameLogic<N, K>::makeMove(int cellIndex)
 {
-    if (cellIndex < 0 || cellIndex >= 9 || board[cellIndex] != CELL_EMPTY) {
+    if (!isCellEmpty(cellIndex)) {
         return false;
     }
 
-    board[cellIndex] = (currentPlayer == PLAYER_X) ? CELL_X : CELL_O;
+    Mask bit = Geometry::bit(cellIndex);
+    int side = (currentPlayer == PLAYER_O);
+    (side ? board.o : board.x) |= bit;
+    toggleMark<N>(hash, side, cellIndex);
+
+    // The lines through this cell can no longer be completed by the other side
+    openLines[1 - side] &= ~Geometry::CELL_LINE_SETS[cellIndex];
+
+    // Only the lines through this cell can have changed. Play that goes on
+    // after a win is rare enough to fall back to the full scan, which
+    // decides between two winners the same way as before.
+    Mask marks = (currentPlayer == PLAYER_X) ? board.x : board.o;
+    if (Geometry::completesLine(marks, cellIndex)) {
+        if (status == GAME_ONGOING) {
+            status = (currentPlayer == PLAYER_X) ? PLAYER_X_WINS : PLAYER_O_WINS;
+        } else {
+            status = evaluateBoard(board);
+        }
+    } else if (status == GAME_ONGOING && !(openLines[0] | openLines[1])) {
+        // Also true of a full board without a winner
+        status = GAME_DRAW;
+    }
+
     currentPlayer = (currentPlayer == PLAYER_X) ? PLAYER_O : PLAYER_X;
     return true;
 }
 
-bool GameLogic::isCellEmpty(int cellIndex) const
+template <int N, int K>
+bool BasicGameLogic<N, K>::isCellEmpty(int cellIndex) const
 {
-    if (cellIndex < 0 || cellIndex >= 9) {
+    if (cellIndex < 0 || cellIndex >= CELL_COUNT) {
         return false;
     }
-    return board[cellIndex] == CELL_EMPTY;
+    return (Geometry::emptyCells(board) >> cellIndex) & 1u;
 }
 
-Cell GameLogic::getCellState(int cellIndex) const
+template <int N, int K>
+Cell BasicGameLogic<N, K>::getCellState(int cellIndex) const
 {
-    if (cellIndex < 0 || cellIndex >= 9) {
+    if (cellIndex < 0 || cellIndex >= CELL_COUNT) {
         return CELL_EMPTY;
     }
-    return board[cellIndex];
+    if ((board.x >> cellIndex) & 1u) {
+        return CELL_X;
+    }
+    if ((board.o >> cellIndex) & 1u) {
+        return CELL_O;
+    }
+    return CELL_EMPTY;
 }
 
-Player GameLogic::getCurrentPlayer() const
+template <int N, int K>
+Player BasicGameLogic<N, K>::getCurrentPlayer() const
 {
     return currentPlayer;
 }
 
-GameResult GameLogic::checkGameStatus() const
+template <int N, int K>
+typename BasicGameLogic<N, K>::Board BasicGameLogic<N, K>::getBoard() const
+{
+    return board;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::copyPosition(const BasicGameLogic &other)
+{
+    board = other.board;
+    hash = other.hash;
+    currentPlayer = other.currentPlayer;
+    status = other.status;
+    openLines[0] = other.openLines[0];
+    openLines[1] = other.openLines[1];
+}
+
+template <int N, int K>
+const TranspositionStats &BasicGameLogic<N, K>::getTranspositionStats() const
+{
+    return tableStats;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::resetTranspositionStats()
+{
+    tableStats = TranspositionStats();
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::setTranspositionTableSize(std::size_t entries)
+{
+    transpositionTable.resize(entries);
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::setThreadCount(int threads)
+{
+    threadCount = std::max(1, threads);
+}
+
+template <int N, int K>
+int BasicGameLogic<N, K>::getThreadCount() const
+{
+    return threadCount;
+}
+
+template <int N, int K>
+bool BasicGameLogic<N, K>::loadTablebase(const std::string &path)
+{
+    std::shared_ptr<BasicTablebase<N, K>> loaded = std::make_shared<BasicTablebase<N, K>>();
+    if (!loaded->load(path)) {
+        return false;
+    }
+    tablebase = loaded;
+    return true;
+}
+
+template <int N, int K>
+bool BasicGameLogic<N, K>::loadOpeningBook(const std::string &path)
+{
+    std::shared_ptr<BasicOpeningBook<N, K>> loaded = std::make_shared<BasicOpeningBook<N, K>>();
+    if (!loaded->load(path)) {
+        return false;
+    }
+    openingBook = loaded;
+    return true;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::setSolvedLookup(bool enabled)
+{
+    solvedLookup = enabled;
+}
+
+template <int N, int K>
+bool BasicGameLogic<N, K>::getSolvedLookup() const
+{
+    return solvedLookup;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::setEvaluator(const StaticEvaluator<Board> &staticEvaluator)
+{
+    evaluator = staticEvaluator;
+    transpositionTable.clear();
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::setEvaluationNoise(int amplitude)
+{
+    amplitude = std::max(0, amplitude);
+    if (amplitude != evaluationNoise) {
+        transpositionTable.clear();
+    }
+    evaluationNoise = amplitude;
+}
+
+template <int N, int K>
+int BasicGameLogic<N, K>::getEvaluationNoise() const
+{
+    return evaluationNoise;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::setParallelMode(ParallelMode mode)
+{
+    parallelMode = mode;
+}
+
+template <int N, int K>
+ParallelMode BasicGameLogic<N, K>::getParallelMode() const
+{
+    return parallelMode;
+}
+
+template <int N, int K>
+const std::vector<ThreadStats> &BasicGameLogic<N, K>::getThreadStats() const
+{
+    return threadStats;
+}
+
+template <int N, int K>
+GameResult BasicGameLogic<N, K>::checkGameStatus() const
 {
-    return evaluateBoard(board);
+    return status;
 }
 
-GameResult GameLogic::evaluateBoard(const std::vector<Cell> &board) const
+template <int N, int K>
+GameResult BasicGameLogic<N, K>::evaluateBoard(const Board &board) const
 {
-    // Check rows
-    for (int i = 0; i < 3; i++) {
-        if (board[i*3] != CELL_EMPTY &&
-            board[i*3] == board[i*3+1] &&
-            board[i*3] == board[i*3+2]) {
-            return (board[i*3] == CELL_X) ? PLAYER_X_WINS : PLAYER_O_WINS;
+    // A side wins when its mask covers a whole winning line, and can still
+    // win while a line holds none of the other side's marks
+    bool open = false;
+    for (Mask line : Geometry::LINES) {
+        if ((board.x & line) == line) {
+            return PLAYER_X_WINS;
         }
+        if ((board.o & line) == line) {
+            return PLAYER_O_WINS;
+        }
+        open = open || !(board.x & line) || !(board.o & line);
     }
+    return open ? GAME_ONGOING : GAME_DRAW;
+}
 
-    // Check columns
-    for (int i = 0; i < 3; i++) {
-        if (board[i] != CELL_EMPTY &&
-            board[i] == board[i+3] &&
-            board[i] == board[i+6]) {
-            return (board[i] == CELL_X) ? PLAYER_X_WINS : PLAYER_O_WINS;
+template <int N, int K>
+int BasicGameLogic<N, K>::getBestMove(const StopToken &stop)
+{
+    // The 3x3 game is solved at compile time, so either side's move is a lookup
+    if constexpr (N == 3 && K == 3) {
+        if (solvedLookup) {
+            return perfectPlayMove(board);
         }
     }
+    if (solvedLookup && tablebase && status == GAME_ONGOING) {
+        return tablebase->bestMove(board);
+    }
+    if (solvedLookup && openingBook && status == GAME_ONGOING) {
+        int move = openingBook->probe(board);
+        if (move >= 0) {
+            return move;
+        }
+    }
+    return search(stop).move;
+}
+
+template <int N, int K>
+int BasicGameLogic<N, K>::getBestMoveBySearch()
+{
+    activeLimits = SearchLimits();
+    transpositionTable.allocate();
+    SharedSearchState shared;
+    shared.stop = false;
+    shared.stopped = false;
+    shared.nodes = 0;
+    shared.token = nullptr;
+    SearchWorker worker = makeWorker(0, &shared);
+
+    int score;
+    int move = searchRoot(worker, -1, CELL_COUNT, -INFINITE_SCORE, INFINITE_SCORE, score);
+    addStats(tableStats, worker.stats);
+    return move;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::setSearchLimits(const SearchLimits &limits)
+{
+    searchLimits = limits;
+}
+
+template <int N, int K>
+SearchLimits BasicGameLogic<N, K>::getSearchLimits() const
+{
+    return searchLimits;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::setSearchWindows(SearchWindows windows)
+{
+    searchWindows = windows;
+}
+
+template <int N, int K>
+SearchWindows BasicGameLogic<N, K>::getSearchWindows() const
+{
+    return searchWindows;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::setMoveOrdering(MoveOrdering ordering)
+{
+    moveOrdering = ordering;
+}
+
+template <int N, int K>
+MoveOrdering BasicGameLogic<N, K>::getMoveOrdering() const
+{
+    return moveOrdering;
+}
+
+template <int N, int K>
+typename BasicGameLogic<N, K>::SearchWorker BasicGameLogic<N, K>::makeWorker(int id, SharedSearchState *shared) const
+{
+    SearchWorker worker;
+    worker.board = board;
+    worker.hash = hash;
+    worker.id = id;
+    worker.horizon = CELL_COUNT;
+    worker.rootDecided = (status != GAME_ONGOING);
+    worker.evaluation = evaluator.evaluate ? evaluator.evaluate(board) : 0;
+    worker.openLines[0] = openLines[0];
+    worker.openLines[1] = openLines[1];
+    std::fill(&worker.killers[0][0], &worker.killers[0][0] + 2 * CELL_COUNT, -1);
+    std::fill(&worker.history[0][0], &worker.history[0][0] + 2 * CELL_COUNT, 0);
+    worker.nodes = 0;
+    worker.flushedNodes = 0;
+    worker.cutoffs = 0;
+    worker.firstMoveCutoffs = 0;
+    worker.aborted = false;
+    worker.stats = TranspositionStats();
+    worker.shared = shared;
+    worker.split = nullptr;
+    return worker;
+}
+
+template <int N, int K>
+SearchResult BasicGameLogic<N, K>::search(const StopToken &stop)
+{
+    SearchResult result = { -1, 0, 0, 0, false, false };
+    Mask rootMoves = distinctMoves<N>(board);
+    if (!rootMoves) {
+        return result;
+    }
+    // Played only if not even the first depth finishes in time
+    result.move = lowestBit(rootMoves);
 
-    // Check diagonals
-    if (board[0] != CELL_EMPTY &&
-        board[0] == board[4] &&
-        board[0] == board[8]) {
-        return (board[0] == CELL_X) ? PLAYER_X_WINS : PLAYER_O_WINS;
+    activeLimits = searchLimits;
+    searchStart = std::chrono::steady_clock::now();
+    noiseSeed = noiseSeed * 6364136223846793005ULL + 1442695040888963407ULL;
+    transpositionTable.allocate();
+    if (evaluationNoise) {
+        // Scores cached by the last search carry its noise
+        transpositionTable.clear();
     }
+    SharedSearchState shared;
+    shared.stop = false;
+    shared.stopped = false;
+    shared.nodes = 0;
+    shared.token = &stop;
+    threadStats.assign(threadCount, ThreadStats());
+    threadTableStats.assign(threadCount, TranspositionStats());
 
-    if (board[2] != CELL_EMPTY &&
-        board[2] == board[4] &&
-        board[2] == board[6]) {
-        return (board[2] == CELL_X) ? PLAYER_X_WINS : PLAYER_O_WINS;
+    if (parallelMode == PARALLEL_YOUNG_BROTHERS && threadCount > 1) {
+        searchYoungBrothers(shared, result);
+    } else {
+        searchLazySmp(shared, result);
     }
 
-    // Check for draw
-    bool hasEmptyCell = false;
-    for (Cell cell : board) {
-        if (cell == CELL_EMPTY) {
-            hasEmptyCell = true;
-            break;
-        }
+    for (int i = 0; i < threadCount; ++i) {
+        result.nodes += threadStats[i].nodes;
+        addStats(tableStats, threadTableStats[i]);
     }
+    result.stopped = shared.stopped;
+    return result;
+}
 
-    return hasEmptyCell ? GAME_ONGOING : GAME_DRAW;
+template <int N, int K>
+void BasicGameLogic<N, K>::searchLazySmp(SharedSearchState &shared, SearchResult &result)
+{
+    // Helpers only fill the shared table; the answer is the main thread's.
+    // A single-threaded search leaves both vectors empty and allocates nothing.
+    std::vector<SearchWorker> helpers;
+    std::vector<std::thread> threads;
+    helpers.reserve(threadCount - 1);
+    for (int id = 1; id < threadCount; ++id) {
+        helpers.push_back(makeWorker(id, &shared));
+    }
+    for (SearchWorker &helper : helpers) {
+        threads.emplace_back([this, &helper]() {
+            SearchResult ignored = { -1, 0, 0, 0, false, false };
+            iterativeDeepening(helper, ignored);
+        });
+    }
+
+    SearchWorker main = makeWorker(0, &shared);
+    iterativeDeepening(main, result);
+    shared.stop = true;
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    threadStats[0].nodes = main.nodes;
+    threadStats[0].cutoffs = main.cutoffs;
+    threadStats[0].firstMoveCutoffs = main.firstMoveCutoffs;
+    threadTableStats[0] = main.stats;
+    for (std::size_t i = 0; i < helpers.size(); ++i) {
+        threadStats[i + 1].nodes = helpers[i].nodes;
+        threadStats[i + 1].cutoffs = helpers[i].cutoffs;
+        threadStats[i + 1].firstMoveCutoffs = helpers[i].firstMoveCutoffs;
+        threadTableStats[i + 1] = helpers[i].stats;
+    }
 }
 
-std::vector<int> GameLogic::getAvailableMoves(const std::vector<Cell> &board) const
+template <int N, int K>
+void BasicGameLogic<N, K>::searchYoungBrothers(SharedSearchState &shared, SearchResult &result)
 {
-    std::vector<int> moves;
-    for (size_t i = 0; i < board.size(); i++) {  // Change 'int' to 'size_t'
-        if (board[i] == CELL_EMPTY) {
-            moves.push_back(i);
+    // This thread is worker 0 of the pool and drives the iterations
+    WorkStealingPool &pool = youngBrothersPool.get(threadCount);
+    pool.resetCounters();
+    activePool = &pool;
+    SearchWorker main = makeWorker(0, &shared);
+    iterativeDeepening(main, result);
+    activePool = nullptr;
+
+    threadStats[0].nodes += main.nodes;
+    threadStats[0].cutoffs += main.cutoffs;
+    threadStats[0].firstMoveCutoffs += main.firstMoveCutoffs;
+    addStats(threadTableStats[0], main.stats);
+    for (int i = 0; i < threadCount; ++i) {
+        threadStats[i].tasks = pool.counters(i).tasks;
+        threadStats[i].steals = pool.counters(i).steals;
+    }
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::iterativeDeepening(SearchWorker &worker, SearchResult &result)
+{
+    int emptyCount = bitCount(Geometry::emptyCells(worker.board));
+    int maxDepth = emptyCount;
+    if (activeLimits.maxDepth > 0) {
+        maxDepth = std::min(maxDepth, activeLimits.maxDepth);
+    }
+
+    // Helpers skip ahead on odd ids and open with a different root move,
+    // so the threads spread over the tree instead of repeating each other
+    int firstDepth = 1 + (worker.id & 1);
+    int firstMove = result.move;
+    if (worker.id > 0) {
+        Mask rootMoves = distinctMoves<N>(worker.board);
+        for (int skip = worker.id % bitCount(rootMoves); skip > 0; --skip) {
+            rootMoves &= rootMoves - 1;
+        }
+        firstMove = lowestBit(rootMoves);
+    }
+
+    // Scores inside the search are the side to move's; results are O's
+    int side = (currentPlayer == PLAYER_O);
+    int lastScore = 0;
+    bool haveScore = false;
+
+    for (int depth = std::min(firstDepth, maxDepth); depth <= maxDepth; ++depth) {
+        // A depth rarely moves the score far from the last one, so it opens
+        // with a narrow window and widens only the side that fails
+        int alpha = -INFINITE_SCORE;
+        int beta = INFINITE_SCORE;
+        int delta = ASPIRATION_WINDOW;
+        if (searchWindows == WINDOWS_ASPIRATION && haveScore && std::abs(lastScore) <= HEURISTIC_LIMIT) {
+            alpha = lastScore - delta;
+            beta = lastScore + delta;
+        }
+
+        // The previous depth's best move is searched first, and the table
+        // holds the rest of its line, so each pass mostly confirms the last
+        int score;
+        int move;
+        for (;;) {
+            move = searchRoot(worker, firstMove, depth, alpha, beta, score);
+            bool unbounded = alpha == -INFINITE_SCORE && beta == INFINITE_SCORE;
+            if (worker.aborted || unbounded || (score > alpha && score < beta)) {
+                break;
+            }
+            delta *= 4;
+            if (score <= alpha) {
+                alpha = score - delta < -HEURISTIC_LIMIT ? -INFINITE_SCORE : score - delta;
+            } else {
+                // A move that beats the window beats every move searched before it
+                firstMove = move;
+                result.move = move;
+                beta = score + delta > HEURISTIC_LIMIT ? INFINITE_SCORE : score + delta;
+            }
+        }
+        if (worker.aborted) {
+            // The last best move was searched first, so any move that
+            // finished ahead of it is an improvement even at this depth.
+            // Below the window all scores are bounds and prove nothing.
+            if (move >= 0 && score > alpha) {
+                result.move = move;
+            }
+            break;
+        }
+        firstMove = move;
+        lastScore = score;
+        haveScore = true;
+        result.move = move;
+        result.score = side ? score : -score;
+        result.depth = depth;
+        result.solved = (depth == emptyCount);
+
+        // A proven result will not change with more depth
+        if (std::abs(score) >= WIN_SCORE - CELL_COUNT) {
+            result.solved = true;
+            break;
+        }
+
+        // The next depth costs more than all previous ones together
+        if (activeLimits.timeLimitMs > 0) {
+            auto elapsed = std::chrono::steady_clock::now() - searchStart;
+            if (elapsed * 2 > std::chrono::milliseconds(activeLimits.timeLimitMs)) {
+                break;
+            }
         }
     }
-    return moves;
 }
 
-int GameLogic::getBestMove()
+template <int N, int K>
+int BasicGameLogic<N, K>::searchRoot(SearchWorker &worker, int firstMove, int depthLimit, int alpha, int beta,
+                                     int &bestScore)
 {
-    int bestScore = -1000;
+    bestScore = -INFINITE_SCORE;
     int bestMove = -1;
+    int side = (currentPlayer == PLAYER_O);
+    worker.horizon = depthLimit - 1;
 
-    std::vector<int> availableMoves = getAvailableMoves(board);
+    // Moves are the empty cells. Moves that mirror an earlier one on a
+    // symmetric board score the same and are skipped.
+    MoveList<CELL_COUNT> moves;
+    orderMoves(worker, moves, distinctMoves<N>(worker.board), firstMove, -1, side);
 
-    for (int move : availableMoves) {
-        std::vector<Cell> boardCopy = board;
-        boardCopy[move] = CELL_O; // AI is always O
+    for (int i = 0; i < moves.count; ++i) {
+        int move = moves.moves[i];
 
-        int score = minimax(boardCopy, 0, false, -1000, 1000);
+        // Ties go to the lowest cell whatever order the moves come in, so a
+        // lower cell searched after the best one only has to equal it
+        bool lowerCell = bestMove >= 0 && move < bestMove;
+        int floor = std::max(alpha, lowerCell ? bestScore - 1 : bestScore);
+        bool nullWindow = bestMove >= 0 && searchWindows != WINDOWS_FULL;
+        int score = searchChild(worker, -1, side, move, nullWindow, floor, beta);
 
-        if (score > bestScore) {
+        if (worker.aborted) {
+            break;
+        }
+        if (score > bestScore || (lowerCell && score == bestScore)) {
             bestScore = score;
             bestMove = move;
         }
+        if (bestScore >= beta) {
+            break;
+        }
+
+        // Once the first move has set a bound the others can run side by side
+        if (activePool && i + 1 < moves.count) {
+            int splitAlpha = alpha;
+            splitMoves(worker, -1, side, moves, i + 1, splitAlpha, beta, bestScore, bestMove);
+            break;
+        }
     }
 
     return bestMove;
 }
 
-int GameLogic::minimax(std::vector<Cell> &board, int depth, bool isMaximizing, int alpha, int beta)
+template <int N, int K>
+int BasicGameLogic<N, K>::searchChild(SearchWorker &worker, int depth, int side, int move, bool nullWindow,
+                                      int alpha, int beta)
 {
-    GameResult result = evaluateBoard(board);
+    // negamaxParallel() hands over to negamax() near the leaves by itself
+    int (BasicGameLogic::*node)(SearchWorker &, int, int, int, int, int) =
+        activePool ? &BasicGameLogic::negamaxParallel : &BasicGameLogic::negamax;
 
-    // Terminal states
-    if (result == PLAYER_X_WINS) return -10 + depth;
-    if (result == PLAYER_O_WINS) return 10 - depth;
-    if (result == GAME_DRAW) return 0;
+    // A null window only tells whether the move beats alpha, which after a
+    // well-ordered first move it mostly does not; only then is it searched
+    // again for its exact score
+    MoveUndo undo = playMove(worker, side, move);
+    int score = -(this->*node)(worker, depth + 1, 1 - side, nullWindow ? -alpha - 1 : -beta, -alpha, move);
+    if (nullWindow && score > alpha && score < beta && !worker.aborted) {
+        score = -(this->*node)(worker, depth + 1, 1 - side, -beta, -alpha, move);
+    }
+    undoMove(worker, side, move, undo);
+    return score;
+}
 
-    std::vector<int> availableMoves = getAvailableMoves(board);
+template <int N, int K>
+void BasicGameLogic<N, K>::orderMoves(const SearchWorker &worker, MoveList<CELL_COUNT> &moves, Mask candidates,
+                                      int hashMove, int depth, int side) const
+{
+    if (moveOrdering == ORDERING_CELLS) {
+        generateMoves(moves, candidates, hashMove);
+        return;
+    }
 
-    if (isMaximizing) {
-        int bestScore = -1000;
-        for (int move : availableMoves) {
-            board[move] = CELL_O;
-            int score = minimax(board, depth + 1, false, alpha, beta);
-            board[move] = CELL_EMPTY;
+    // The stored move, then this depth's killers: a move that refuted one
+    // line here often refutes its siblings too
+    moves.count = 0;
+    int leading[3] = { hashMove, depth >= 0 ? worker.killers[depth][0] : -1,
+                       depth >= 0 ? worker.killers[depth][1] : -1 };
+    for (int move : leading) {
+        if (move >= 0 && (candidates & Geometry::bit(move))) {
+            moves.moves[moves.count++] = static_cast<signed char>(move);
+            candidates &= ~Geometry::bit(move);
+        }
+    }
 
-            bestScore = std::max(bestScore, score);
-            alpha = std::max(alpha, bestScore);
-            if (beta <= alpha) break;  // Alpha-beta pruning
+    // The rest by history, and while that is even, cells on more winning
+    // lines first (the centre, then the corners on 3x3); lowest cell among
+    // equals. Insertion sort is the fastest for a couple of dozen moves.
+    int first = moves.count;
+    int keys[CELL_COUNT];
+    while (candidates) {
+        int move = popLowestBit(candidates);
+        int key = worker.history[side][move] * 32 + Geometry::CELL_LINES[move].count;
+        int i = moves.count++;
+        for (; i > first && keys[i - 1] < key; --i) {
+            moves.moves[i] = moves.moves[i - 1];
+            keys[i] = keys[i - 1];
         }
-        return bestScore;
-    } else {
-        int bestScore = 1000;
-        for (int move : availableMoves) {
-            board[move] = CELL_X;
-            int score = minimax(board, depth + 1, true, alpha, beta);
-            board[move] = CELL_EMPTY;
+        moves.moves[i] = static_cast<signed char>(move);
+        keys[i] = key;
+    }
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::recordCutoff(SearchWorker &worker, int depth, int side, int draft, int move,
+                                        bool firstMove)
+{
+    ++worker.cutoffs;
+    worker.firstMoveCutoffs += firstMove;
+
+    if (worker.killers[depth][0] != move) {
+        worker.killers[depth][1] = worker.killers[depth][0];
+        worker.killers[depth][0] = static_cast<signed char>(move);
+    }
+
+    // Deep cutoffs save the most work and weigh the most
+    int &score = worker.history[side][move];
+    score += draft * draft;
+    if (score > HISTORY_LIMIT) {
+        for (int &cell : worker.history[side]) {
+            cell /= 2;
+        }
+    }
+}
 
-            bestScore = std::min(bestScore, score);
-            beta = std::min(beta, bestScore);
-            if (beta <= alpha) break;  // Alpha-beta pruning
+template <int N, int K>
+typename BasicGameLogic<N, K>::MoveUndo BasicGameLogic<N, K>::playMove(SearchWorker &worker, int side, int move) const
+{
+    MoveUndo undo = { worker.evaluation, worker.openLines[1 - side] };
+    if (evaluator.moveDelta) {
+        worker.evaluation += evaluator.moveDelta(worker.board, move, side);
+    }
+    (side ? worker.board.o : worker.board.x) |= Geometry::bit(move);
+    toggleMark<N>(worker.hash, side, move);
+    worker.openLines[1 - side] &= ~Geometry::CELL_LINE_SETS[move];
+    return undo;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::undoMove(SearchWorker &worker, int side, int move, const MoveUndo &undo) const
+{
+    toggleMark<N>(worker.hash, side, move);
+    (side ? worker.board.o : worker.board.x) &= ~Geometry::bit(move);
+    worker.evaluation = undo.evaluation;
+    worker.openLines[1 - side] = undo.openLines;
+}
+
+template <int N, int K>
+bool BasicGameLogic<N, K>::budgetExceeded(SearchWorker &worker) const
+{
+    SharedSearchState &shared = *worker.shared;
+    if (shared.stop.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    // Nodes reach the shared count in batches, to keep threads off one cache line
+    bool checkpoint = (worker.nodes & 255) == 0;
+    if (checkpoint) {
+        flushNodes(worker);
+    }
+
+    bool exceeded = false;
+    if (checkpoint && shared.token && shared.token->stopRequested()) {
+        shared.stopped = true;
+        exceeded = true;
+    }
+    if (!exceeded && activeLimits.maxNodes > 0) {
+        std::uint64_t total = shared.nodes.load(std::memory_order_relaxed) + worker.nodes - worker.flushedNodes;
+        exceeded = total >= activeLimits.maxNodes;
+    }
+    // Reading the clock at every node would cost more than the node itself
+    if (!exceeded && activeLimits.timeLimitMs > 0 && checkpoint) {
+        auto elapsed = std::chrono::steady_clock::now() - searchStart;
+        exceeded = elapsed >= std::chrono::milliseconds(activeLimits.timeLimitMs);
+    }
+
+    if (exceeded) {
+        shared.stop = true;
+    }
+    return exceeded;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::flushNodes(SearchWorker &worker) const
+{
+    worker.shared->nodes.fetch_add(worker.nodes - worker.flushedNodes, std::memory_order_relaxed);
+    worker.flushedNodes = worker.nodes;
+}
+
+template <int N, int K>
+bool BasicGameLogic<N, K>::splitCancelled(const SplitPoint *split)
+{
+    for (; split; split = split->parent) {
+        if (split->cancelled.load(std::memory_order_relaxed)) {
+            return true;
         }
-        return bestScore;
     }
+    return false;
 }
+
+template <int N, int K>
+GameResult BasicGameLogic<N, K>::resultAfterMove(const SearchWorker &worker, int side, int lastMove) const
+{
+    // The search stops at finished positions, so below an undecided root
+    // only the side that just moved can have won, on a line through its move
+    const Board &board = worker.board;
+    if (worker.rootDecided) {
+        return evaluateBoard(board);
+    }
+    if (Geometry::completesLine(side ? board.x : board.o, lastMove)) {
+        return side ? PLAYER_X_WINS : PLAYER_O_WINS;
+    }
+
+    // Once no line is left to either side nothing below can change the score
+    return (worker.openLines[0] | worker.openLines[1]) ? GAME_ONGOING : GAME_DRAW;
+}
+
+template <int N, int K>
+bool BasicGameLogic<N, K>::enterNode(SearchWorker &worker, int depth, int side,
+                                     int &alpha, int &beta, int lastMove, NodeInfo &node, int &score)
+{
+    if (worker.aborted || budgetExceeded(worker) || splitCancelled(worker.split)) {
+        worker.aborted = true;
+        score = 0;
+        return true;
+    }
+    ++worker.nodes;
+
+    const Board &board = worker.board;
+    GameResult result = resultAfterMove(worker, side, lastMove);
+
+    // Terminal states, scored for the side to move
+    score = 0;
+    if (result == PLAYER_X_WINS) score = side ? -WIN_SCORE + depth : WIN_SCORE - depth;
+    if (result == PLAYER_O_WINS) score = side ? WIN_SCORE - depth : -WIN_SCORE + depth;
+    if (result != GAME_ONGOING) return true;
+
+    // Past the horizon only the static evaluation (O's) is known
+    if (depth >= worker.horizon) {
+        int evaluation = worker.evaluation;
+        if (evaluationNoise) {
+            std::uint64_t key = worker.hash.orientations[canonicalOrientation(worker.hash)];
+            evaluation += noiseFor(key, noiseSeed, evaluationNoise);
+        }
+        evaluation = side ? evaluation : -evaluation;
+        score = std::max(-HEURISTIC_LIMIT, std::min(HEURISTIC_LIMIT, evaluation));
+        return true;
+    }
+
+    // Searching deeper than the empty cells is the same as searching to the end
+    node.draft = std::min(worker.horizon - depth, bitCount(Geometry::emptyCells(board)));
+
+    // Symmetric positions share one entry, keyed and stored in the
+    // canonical orientation. The same marks can be reached with either
+    // side to move, and scores are that side's.
+    node.orientation = canonicalOrientation(worker.hash);
+    node.key = worker.hash.orientations[node.orientation];
+    if (side) {
+        node.key ^= ZOBRIST.oToMove;
+    }
+    node.alphaOriginal = alpha;
+    node.betaOriginal = beta;
+    node.hashMove = -1;
+
+    // A shallower entry cannot decide the node but its move is still the best guess
+    TranspositionEntry entry;
+    if (transpositionTable.probe(node.key, entry, worker.stats)) {
+        if (entry.depth >= node.draft) {
+            score = scoreFromTable(entry.score, depth);
+            if (entry.bound == BOUND_EXACT) return true;
+            if (entry.bound == BOUND_LOWER) alpha = std::max(alpha, score);
+            if (entry.bound == BOUND_UPPER) beta = std::min(beta, score);
+            if (beta <= alpha) return true;
+        }
+        if (entry.bestMove >= 0) {
+            int move = SYMMETRY<N>.inverseCells[node.orientation][entry.bestMove];
+            if (Geometry::emptyCells(board) & Geometry::bit(move)) {
+                node.hashMove = move;
+            }
+        }
+    }
+    return false;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::storeNode(SearchWorker &worker, const NodeInfo &node, int depth, int bestScore, int bestMove)
+{
+    BoundType bound = BOUND_EXACT;
+    if (bestScore <= node.alphaOriginal) {
+        bound = BOUND_UPPER;
+    } else if (bestScore >= node.betaOriginal) {
+        bound = BOUND_LOWER;
+    }
+    int storedMove = bestMove >= 0 ? SYMMETRY<N>.cells[node.orientation][bestMove] : -1;
+    transpositionTable.store(node.key, scoreToTable(bestScore, depth), bound, storedMove, node.draft, worker.stats);
+}
+
+template <int N, int K>
+int BasicGameLogic<N, K>::negamax(SearchWorker &worker, int depth, int side, int alpha, int beta, int lastMove)
+{
+    NodeInfo node;
+    int score;
+    if (enterNode(worker, depth, side, alpha, beta, lastMove, node, score)) {
+        return score;
+    }
+
+    Board &board = worker.board;
+    MoveList<CELL_COUNT> moves;
+    orderMoves(worker, moves, Geometry::emptyCells(board), node.hashMove, depth, side);
+
+    int bestScore = -INFINITE_SCORE;
+    int bestMove = -1;
+    for (int i = 0; i < moves.count; ++i) {
+        int move = moves.moves[i];
+        bool nullWindow = i > 0 && searchWindows != WINDOWS_FULL;
+        score = searchChild(worker, depth, side, move, nullWindow, alpha, beta);
+        // An aborted child's score is a placeholder, not a refutation
+        if (worker.aborted) {
+            break;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+        }
+        alpha = std::max(alpha, bestScore);
+        if (alpha >= beta) {  // Alpha-beta pruning
+            recordCutoff(worker, depth, side, node.draft, move, i == 0);
+            break;
+        }
+    }
+
+    if (worker.aborted) {
+        return 0;
+    }
+    storeNode(worker, node, depth, bestScore, bestMove);
+    return bestScore;
+}
+
+template <int N, int K>
+int BasicGameLogic<N, K>::negamaxParallel(SearchWorker &worker, int depth, int side, int alpha, int beta, int lastMove)
+{
+    // Near the leaves a subtree is cheaper to search than to hand out
+    if (worker.horizon - depth < SPLIT_MIN_DRAFT) {
+        return negamax(worker, depth, side, alpha, beta, lastMove);
+    }
+
+    NodeInfo node;
+    int score;
+    if (enterNode(worker, depth, side, alpha, beta, lastMove, node, score)) {
+        return score;
+    }
+
+    // The eldest brother (the first in move order) is searched
+    // alone to establish a bound; the younger ones wait for it
+    Board &board = worker.board;
+    MoveList<CELL_COUNT> moves;
+    orderMoves(worker, moves, Geometry::emptyCells(board), node.hashMove, depth, side);
+    int bestMove = moves.moves[0];
+    int bestScore = searchChild(worker, depth, side, bestMove, false, alpha, beta);
+    if (worker.aborted) {
+        return 0;
+    }
+    alpha = std::max(alpha, bestScore);
+
+    bool firstMoveCutoff = alpha >= beta;
+    if (!firstMoveCutoff && moves.count > 1) {
+        splitMoves(worker, depth, side, moves, 1, alpha, beta, bestScore, bestMove);
+    }
+
+    if (worker.aborted) {
+        return 0;
+    }
+    if (alpha >= beta) {
+        recordCutoff(worker, depth, side, node.draft, bestMove, firstMoveCutoff);
+    }
+    storeNode(worker, node, depth, bestScore, bestMove);
+    return bestScore;
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::splitMoves(SearchWorker &worker, int depth, int side,
+                                      const MoveList<CELL_COUNT> &moves, int first,
+                                      int &alpha, int beta, int &bestScore, int &bestMove)
+{
+    SplitPoint split;
+    split.windowAlpha = alpha;
+    split.alpha = std::max(alpha, bestScore);
+    split.beta = beta;
+    split.bestScore = bestScore;
+    split.bestMove = bestMove;
+    split.cancelled = false;
+    split.parent = worker.split;
+
+    // Pushed last move first, so the owner pops them in search order while
+    // idle threads steal from the other end
+    for (int i = moves.count - 1; i >= first; --i) {
+        int move = moves.moves[i];
+        activePool->submit(split.group, [this, &split, &worker, move, depth, side]() {
+            searchSplitMove(split, worker, move, depth, side);
+        });
+    }
+    activePool->wait(split.group);
+
+    alpha = split.alpha;
+    bestScore = split.bestScore;
+    bestMove = split.bestMove;
+
+    // Moves that stopped early because the search ended or an enclosing
+    // split point was cut off leave this node's result incomplete
+    if (worker.shared->stop.load() || splitCancelled(worker.split)) {
+        worker.aborted = true;
+    }
+}
+
+template <int N, int K>
+void BasicGameLogic<N, K>::searchSplitMove(SplitPoint &split, const SearchWorker &owner, int move, int depth, int side)
+{
+    if (splitCancelled(&split)) {
+        return;
+    }
+
+    SearchWorker worker = owner;
+    worker.nodes = 0;
+    worker.flushedNodes = 0;
+    worker.cutoffs = 0;
+    worker.firstMoveCutoffs = 0;
+    worker.aborted = false;
+    worker.stats = TranspositionStats();
+    worker.split = &split;
+
+    // At the root ties go to the lowest cell, as in searchRoot(): a cell
+    // below the best so far only has to equal it
+    int alpha, beta;
+    {
+        std::lock_guard<std::mutex> guard(split.lock);
+        bool lowerCell = depth < 0 && move < split.bestMove;
+        alpha = lowerCell ? std::max(split.windowAlpha, split.bestScore - 1) : split.alpha;
+        beta = split.beta;
+    }
+
+    // Younger brothers are the ones a null window is for
+    int score = searchChild(worker, depth, side, move, searchWindows != WINDOWS_FULL, alpha, beta);
+
+    // Each pool thread only touches its own slot
+    flushNodes(worker);
+    int thread = activePool->currentWorker();
+    threadStats[thread].nodes += worker.nodes;
+    threadStats[thread].cutoffs += worker.cutoffs;
+    threadStats[thread].firstMoveCutoffs += worker.firstMoveCutoffs;
+    addStats(threadTableStats[thread], worker.stats);
+
+    if (worker.aborted) {
+        return;
+    }
+
+    // A score above the window it was searched with is exact, so it ties
+    // with the best even if that changed in the meantime
+    std::lock_guard<std::mutex> guard(split.lock);
+    bool exactTie = depth < 0 && score > alpha && score == split.bestScore && move < split.bestMove;
+    if (score > split.bestScore || exactTie) {
+        split.bestScore = score;
+        split.bestMove = move;
+    }
+    split.alpha = std::max(split.alpha, score);
+    // A refutation makes the brothers still running irrelevant
+    if (split.alpha >= split.beta) {
+        split.cancelled = true;
+    }
+}
+
+template class BasicGameLogic<3, 3>;
+template class BasicGameLogic<4, 4>;
+template class BasicGameLogic<5, 4>;
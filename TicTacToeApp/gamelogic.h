@@ -2,31 +2,240 @@
 #ifndef GAMELOGIC_H
 #define GAMELOGIC_H
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
+#include "bitboard.h"
+#include "evaluator.h"
+#include "movelist.h"
+#include "openingbook.h"
+#include "search.h"
+#include "stoptoken.h"
+#include "symmetry.h"
+#include "tablebase.h"
+#include "transpositiontable.h"
+#include "workstealingpool.h"
 
 enum Cell { CELL_EMPTY, CELL_X, CELL_O };
 enum Player { PLAYER_X, PLAYER_O };
 enum GameResult { GAME_ONGOING, PLAYER_X_WINS, PLAYER_O_WINS, GAME_DRAW };
 
-class GameLogic
+// Game on an N x N board where K marks in a row win. Cell indices run row
+// by row from 0 to N * N - 1. Winning lines, masks and symmetry tables are
+// compile-time constants of each instantiation, so the search loops have
+// fixed bounds.
+template <int N, int K>
+class BasicGameLogic
 {
 public:
-    GameLogic();
+    typedef BoardGeometry<N, K> Geometry;
+    typedef typename Geometry::Mask Mask;
+    typedef typename Geometry::Board Board;
+    typedef typename Geometry::LineSet LineSet;
+
+    static constexpr int BOARD_SIZE = N;
+    static constexpr int WIN_LENGTH = K;
+    static constexpr int CELL_COUNT = N * N;
+
+    BasicGameLogic();
     void resetGame();
     bool makeMove(int cellIndex);
     bool isCellEmpty(int cellIndex) const;
     Cell getCellState(int cellIndex) const;
     Player getCurrentPlayer() const;
+    // A draw as soon as every line holds both marks, before the board fills
     GameResult checkGameStatus() const;
-    int getBestMove(); // AI move using minimax
+    Board getBoard() const;
+
+    // Takes over other's position but keeps this engine's table and settings
+    void copyPosition(const BasicGameLogic &other);
+    // Move for the side to move, looked up in a solved table or the opening
+    // book when lookups are on, searched within the search limits otherwise
+    int getBestMove(const StopToken &stop = StopToken());
+    int getBestMoveBySearch(); // Reference move: one search to the end of the game
+
+    // Iterative deepening within the search limits. The stop token is read
+    // every few hundred nodes and ends the search like an exhausted budget.
+    // The move is the best of the last depth that finished, or of the
+    // unfinished one if a move searched there already beat it.
+    SearchResult search(const StopToken &stop = StopToken());
+    void setSearchLimits(const SearchLimits &limits);
+    SearchLimits getSearchLimits() const;
+    void setSearchWindows(SearchWindows windows); // Aspiration windows by default
+    SearchWindows getSearchWindows() const;
+    void setMoveOrdering(MoveOrdering ordering); // History ordering by default
+    MoveOrdering getMoveOrdering() const;
+
+    // Once a solved table is loaded, getBestMove() looks its answer up
+    // instead of searching. False if the file is missing or was built for
+    // another board. Copies of the game share the table.
+    bool loadTablebase(const std::string &path);
+    // The first moves come from an opening book, the one compiled in for
+    // 4x4 unless another is loaded. False as for loadTablebase().
+    bool loadOpeningBook(const std::string &path);
+    // Tables and books are used by default; without them the AI plays only
+    // as well as its search limits allow
+    void setSolvedLookup(bool enabled);
+    bool getSolvedLookup() const;
+
+    // Scores positions where a depth-limited search stops; open lines by
+    // default. An evaluator with null functions scores them all as even.
+    // Both setters empty the transposition table of the old scores.
+    void setEvaluator(const StaticEvaluator<Board> &evaluator);
+    // Adds up to amplitude either way to each static score, the same for a
+    // position throughout one search but different from search to search;
+    // with noise, every search starts from an empty table. Wins and losses
+    // are never blurred. 0, the default, adds nothing.
+    void setEvaluationNoise(int amplitude);
+    int getEvaluationNoise() const;
+
+    // Search cache statistics, for sizing the table
+    const TranspositionStats &getTranspositionStats() const;
+    void resetTranspositionStats();
+    void setTranspositionTableSize(std::size_t entries);
+
+    // Threads used by search(). With Lazy SMP, extra threads search the
+    // same position at staggered depths and share the transposition table.
+    // With Young Brothers Wait, each node searches its first move alone and
+    // then hands the other moves to a work-stealing pool, started by the
+    // first such search and kept for the next ones.
+    void setThreadCount(int threads);
+    int getThreadCount() const;
+    void setParallelMode(ParallelMode mode);
+    ParallelMode getParallelMode() const;
+    const std::vector<ThreadStats> &getThreadStats() const; // One entry per thread, last search
 
 private:
-    std::vector<Cell> board;
+    // Shared by every thread of one search
+    struct SharedSearchState
+    {
+        std::atomic<bool> stop; // Raised when the search ends or runs out of budget
+        std::atomic<bool> stopped; // The stop token ended it
+        std::atomic<std::uint64_t> nodes;
+        const StopToken *token;
+    };
+
+    // A node whose remaining moves are being searched by several threads.
+    // Its window and best move are updated as the moves finish; a cutoff
+    // cancels the moves still running, and every split point below them.
+    struct SplitPoint
+    {
+        std::mutex lock;
+        int windowAlpha; // Alpha the node was entered with
+        int alpha;
+        int beta;
+        int bestScore;
+        int bestMove;
+        std::atomic<bool> cancelled;
+        const SplitPoint *parent;
+        TaskGroup group;
+    };
+
+    // State of one search thread, or of one split subtree; the
+    // transposition table is shared
+    struct SearchWorker
+    {
+        Board board;
+        SymmetricHash hash;
+        int id;
+        int horizon; // Depth at which negamax() stops and scores the position statically
+        bool rootDecided; // The game was already over where the search started
+        int evaluation; // Static score of board, updated move by move
+        LineSet openLines[2]; // As GameLogic::openLines, updated move by move
+        signed char killers[CELL_COUNT][2]; // Last two moves that failed high at each depth, -1 if none
+        int history[2][CELL_COUNT]; // Per side and cell, grows with the draft of each cutoff the move made
+        std::uint64_t nodes;
+        std::uint64_t flushedNodes; // Part of nodes already added to the shared count
+        std::uint64_t cutoffs;
+        std::uint64_t firstMoveCutoffs;
+        bool aborted;
+        TranspositionStats stats;
+        SharedSearchState *shared;
+        const SplitPoint *split; // Innermost split point this subtree belongs to
+    };
+
+    // What playMove() changes besides the marks, for undoMove() to put back
+    struct MoveUndo
+    {
+        int evaluation;
+        LineSet openLines; // The opponent's
+    };
+
+    // What negamax() learns about a node before searching its moves
+    struct NodeInfo
+    {
+        std::uint64_t key;
+        int orientation;
+        int draft;
+        int hashMove;
+        int alphaOriginal;
+        int betaOriginal;
+    };
+
+    Board board;
+    SymmetricHash hash; // Zobrist hashes of the marks, in every orientation
     Player currentPlayer;
+    GameResult status; // Kept up to date by makeMove()
+    LineSet openLines[2]; // Lines X (0) and O (1) can still complete: those free of the other's marks
+    TranspositionTable transpositionTable;
+    TranspositionStats tableStats;
+    int threadCount;
+    ParallelMode parallelMode;
+    ReusablePool youngBrothersPool; // Threads kept between Young Brothers Wait searches
+    WorkStealingPool *activePool; // Set while a Young Brothers Wait search runs
+    StaticEvaluator<Board> evaluator;
+    std::shared_ptr<const BasicTablebase<N, K>> tablebase;
+    std::shared_ptr<const BasicOpeningBook<N, K>> openingBook;
+    bool solvedLookup;
+    int evaluationNoise;
+    std::uint64_t noiseSeed; // Changed by every search
+    std::vector<ThreadStats> threadStats;
+    std::vector<TranspositionStats> threadTableStats;
+
+    SearchLimits searchLimits;
+    SearchWindows searchWindows;
+    MoveOrdering moveOrdering;
+    SearchLimits activeLimits; // Limits of the search in progress
+    std::chrono::steady_clock::time_point searchStart;
 
-    int minimax(std::vector<Cell> &board, int depth, bool isMaximizing, int alpha, int beta);
-    GameResult evaluateBoard(const std::vector<Cell> &board) const;
-    std::vector<int> getAvailableMoves(const std::vector<Cell> &board) const;
+    SearchWorker makeWorker(int id, SharedSearchState *shared) const;
+    void searchLazySmp(SharedSearchState &shared, SearchResult &result);
+    void searchYoungBrothers(SharedSearchState &shared, SearchResult &result);
+    void iterativeDeepening(SearchWorker &worker, SearchResult &result);
+    int searchRoot(SearchWorker &worker, int firstMove, int depthLimit, int alpha, int beta, int &bestScore);
+    void orderMoves(const SearchWorker &worker, MoveList<CELL_COUNT> &moves, Mask candidates, int hashMove,
+                    int depth, int side) const;
+    static void recordCutoff(SearchWorker &worker, int depth, int side, int draft, int move, bool firstMove);
+    MoveUndo playMove(SearchWorker &worker, int side, int move) const;
+    void undoMove(SearchWorker &worker, int side, int move, const MoveUndo &undo) const;
+    bool budgetExceeded(SearchWorker &worker) const;
+    void flushNodes(SearchWorker &worker) const;
+    static bool splitCancelled(const SplitPoint *split);
+    GameResult resultAfterMove(const SearchWorker &worker, int side, int lastMove) const;
+    bool enterNode(SearchWorker &worker, int depth, int side, int &alpha, int &beta, int lastMove,
+                   NodeInfo &node, int &score);
+    void storeNode(SearchWorker &worker, const NodeInfo &node, int depth, int bestScore, int bestMove);
+    int searchChild(SearchWorker &worker, int depth, int side, int move, bool nullWindow, int alpha, int beta);
+    int negamax(SearchWorker &worker, int depth, int side, int alpha, int beta, int lastMove);
+    int negamaxParallel(SearchWorker &worker, int depth, int side, int alpha, int beta, int lastMove);
+    void splitMoves(SearchWorker &worker, int depth, int side, const MoveList<CELL_COUNT> &moves, int first,
+                    int &alpha, int beta, int &bestScore, int &bestMove);
+    void searchSplitMove(SplitPoint &split, const SearchWorker &owner, int move, int depth, int side);
+    GameResult evaluateBoard(const Board &board) const;
 };
 
+// The supported boards are compiled once, in gamelogic.cpp
+extern template class BasicGameLogic<3, 3>;
+extern template class BasicGameLogic<4, 4>;
+extern template class BasicGameLogic<5, 4>;
+
+typedef BasicGameLogic<3, 3> GameLogic;
+typedef BasicGameLogic<4, 4> GameLogic4x4;
+typedef BasicGameLogic<5, 4> GameLogic5x5;
+
 #endif // GAMELOGIC_H
@@ -1,12 +1,20 @@
 #include "gamewindow.h"
 #include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
+#include <memory>
 
 GameWindow::GameWindow(QWidget *parent)
-    : QMainWindow(parent), vsAI(true), loggedIn(false)
+    : QMainWindow(parent), vsAI(true), difficulty(DIFFICULTY_PERFECT), engineType(ENGINE_ALPHA_BETA), aiRequest(0), aiThinking(false), loggedIn(false)
 {
     gameLogic = new GameLogic();
+    ponderer = new Ponderer();
+    ponderer->setDifficulty(difficulty);
+    ponderer->setEngineType(engineType);
     userAuth = new UserAuth();
 
+    // The AI answers from a worker thread; handle the reply on this one
+    connect(this, &GameWindow::aiMoveReady, this, &GameWindow::applyAIMove, Qt::QueuedConnection);
+
     // Set a consistent stylesheet for the QMainWindow to override system theme
     this->setStyleSheet("QMainWindow {"
                         "background: qlineargradient(x1:0, y1:0, x2:1, y2:1,"
@@ -22,6 +30,10 @@ GameWindow::GameWindow(QWidget *parent)
 
 GameWindow::~GameWindow()
 {
+    // The search emits through this window when it finishes
+    aiStop.requestStop();
+    aiSearch.waitForFinished();
+    delete ponderer;
     delete gameLogic;
     delete userAuth;
 }
@@ -116,8 +128,38 @@ void GameWindow::setupUI()
                                   "}");
     connect(gameModeButton, &QPushButton::clicked, this, &GameWindow::toggleGameMode);
 
+    difficultyButton = new QPushButton(QString("AI: %1").arg(difficultySettings(difficulty).name));
+    difficultyButton->setStyleSheet("QPushButton {"
+                                    "background-color: #00adb5;"
+                                    "color: #ffffff;"
+                                    "padding: 8px 16px;"
+                                    "border: none;"
+                                    "border-radius: 5px;"
+                                    "font-size: 14px;"
+                                    "}"
+                                    "QPushButton:hover {"
+                                    "background-color: #00d4dd;"
+                                    "}");
+    connect(difficultyButton, &QPushButton::clicked, this, &GameWindow::cycleDifficulty);
+
+    engineButton = new QPushButton(engineLabel(engineType));
+    engineButton->setStyleSheet("QPushButton {"
+                                "background-color: #00adb5;"
+                                "color: #ffffff;"
+                                "padding: 8px 16px;"
+                                "border: none;"
+                                "border-radius: 5px;"
+                                "font-size: 14px;"
+                                "}"
+                                "QPushButton:hover {"
+                                "background-color: #00d4dd;"
+                                "}");
+    connect(engineButton, &QPushButton::clicked, this, &GameWindow::toggleEngine);
+
     controlsLayout->addWidget(resetButton);
     controlsLayout->addWidget(gameModeButton);
+    controlsLayout->addWidget(difficultyButton);
+    controlsLayout->addWidget(engineButton);
 
     gameLayout->addLayout(controlsLayout);
     stackedWidget->addWidget(gameScreen);
@@ -502,8 +544,42 @@ void GameWindow::toggleGameMode()
     resetGame();
 }
 
+void GameWindow::cycleDifficulty()
+{
+    // A new strength starts a new game. Resetting waits for the AI's search
+    // and the pondering to end, so the ponderer swaps its engine without
+    // holding up the window.
+    difficulty = Difficulty((difficulty + 1) % DIFFICULTY_COUNT);
+    difficultyButton->setText(QString("AI: %1").arg(difficultySettings(difficulty).name));
+    resetGame();
+    ponderer->setDifficulty(difficulty);
+}
+
+void GameWindow::toggleEngine()
+{
+    // Like a new strength, a new engine starts a new game
+    engineType = engineType == ENGINE_ALPHA_BETA ? ENGINE_MCTS : ENGINE_ALPHA_BETA;
+    engineButton->setText(engineLabel(engineType));
+    resetGame();
+    ponderer->setEngineType(engineType);
+}
+
+QString GameWindow::engineLabel(EngineType type)
+{
+    return type == ENGINE_MCTS ? "Engine: Monte Carlo" : "Engine: Minimax";
+}
+
 void GameWindow::resetGame()
 {
+    // A search still running belongs to the old game; once it returns no
+    // task is left to emit through this window but the next one
+    aiStop.requestStop();
+    aiSearch.waitForFinished();
+    ponderer->stop(); // Nor is the old position worth pondering
+    ++aiRequest;
+    aiThinking = false;
+    setBoardLocked(false);
+
     gameLogic->resetGame();
     updateBoardUI();
     statusLabel->setText("X's turn");
@@ -514,7 +590,7 @@ void GameWindow::cellClicked()
     QPushButton *clickedButton = qobject_cast<QPushButton*>(sender());
     int cellIndex = cells.indexOf(clickedButton);
 
-    if (cellIndex == -1 || !gameLogic->isCellEmpty(cellIndex)) {
+    if (aiThinking || cellIndex == -1 || !gameLogic->isCellEmpty(cellIndex)) {
         return;
     }
 
@@ -538,7 +614,31 @@ void GameWindow::cellClicked()
 
 void GameWindow::makeAIMove()
 {
-    int aiMove = gameLogic->getBestMove();
+    // Search a copy of the board on a pool thread so the window keeps
+    // painting; the board stays locked until the reply arrives. When the
+    // ponderer already searched this reply the answer is immediate.
+    aiThinking = true;
+    setBoardLocked(true);
+    statusLabel->setText("O is thinking...");
+
+    std::shared_ptr<GameLogic> snapshot = std::make_shared<GameLogic>(*gameLogic);
+    int request = aiRequest;
+    aiSearch.waitForFinished(); // The last task has emitted; let it return
+    aiStop = StopSource();
+    StopToken stop = aiStop.getToken();
+    aiSearch = QtConcurrent::run([this, snapshot, request, stop]() {
+        emit aiMoveReady(ponderer->bestMove(*snapshot, stop), request);
+    });
+}
+
+void GameWindow::applyAIMove(int aiMove, int request)
+{
+    if (request != aiRequest) {
+        return; // The game was reset while the AI was thinking
+    }
+    aiThinking = false;
+    setBoardLocked(false);
+
     if (aiMove != -1) {
         gameLogic->makeMove(aiMove);
         updateBoardUI();
@@ -550,6 +650,14 @@ void GameWindow::makeAIMove()
         }
 
         statusLabel->setText("X's turn");
+        ponderer->start(*gameLogic);
+    }
+}
+
+void GameWindow::setBoardLocked(bool locked)
+{
+    for (QPushButton *cell : cells) {
+        cell->setEnabled(!locked);
     }
 }
 
@@ -611,7 +719,10 @@ void GameWindow::handleGameOver(GameResult result)
         statusLabel->setText("O wins!");
         break;
     case GAME_DRAW:
-        message = "Game ended in a draw!";
+        // The game stops as soon as neither side can complete a line
+        message = GameLogic::Geometry::emptyCells(gameLogic->getBoard())
+                      ? "Game ended in a draw: no line can be completed any more!"
+                      : "Game ended in a draw!";
         statusLabel->setText("Game ended in a draw!");
         break;
     default:
@@ -17,7 +17,11 @@
 #include <QTableWidget>
 #include <QHeaderView> // Added for table header operations
 #include <QRegularExpression> // Added for parsing history strings
+#include <QFuture>
+#include "difficulty.h"
 #include "gamelogic.h"
+#include "ponderer.h"
+#include "stoptoken.h"
 #include "userauth.h"
 
 class GameWindow : public QMainWindow
@@ -28,6 +32,10 @@ public:
     explicit GameWindow(QWidget *parent = nullptr);
     ~GameWindow();
 
+signals:
+    // Emitted from the AI's worker thread, delivered queued on the GUI thread
+    void aiMoveReady(int move, int request);
+
 private slots:
     void cellClicked();
     void resetGame();
@@ -37,9 +45,12 @@ private slots:
     void loginUser();
     void registerUser();
     void toggleGameMode();
+    void cycleDifficulty();
+    void toggleEngine();
     void showGameHistory();
     void handleGameOver(GameResult result);
     void showGameModeDialog();
+    void applyAIMove(int move, int request);
 
 private:
     // UI Components
@@ -52,7 +63,17 @@ private:
     QLabel *statusLabel;
     QPushButton *resetButton;
     QPushButton *gameModeButton;
+    QPushButton *difficultyButton;
+    QPushButton *engineButton;
     bool vsAI;
+    Difficulty difficulty;
+    EngineType engineType;
+
+    // AI search running on a snapshot of the board
+    QFuture<void> aiSearch;
+    StopSource aiStop; // Cancels the running search
+    int aiRequest; // Bumped when the game is reset, so late replies are dropped
+    bool aiThinking;
 
     // Login screen
     QWidget *loginScreen;
@@ -81,6 +102,7 @@ private:
 
     // Core components
     GameLogic *gameLogic;
+    Ponderer *ponderer; // The AI's engine; thinks ahead on the human's time
     UserAuth *userAuth;
 
     void setupUI();
@@ -90,8 +112,10 @@ private:
     void setupRegisterScreen();
     void updateBoardUI();
     void makeAIMove();
+    void setBoardLocked(bool locked);
     void applyStyleSheet();
     void highlightWinningCells();
+    static QString engineLabel(EngineType type);
     bool loggedIn;
     QString currentUser;
 };
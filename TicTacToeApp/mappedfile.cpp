@@ -0,0 +1,140 @@
+// mappedfile.cpp
+#include "mappedfile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile()
+    : mapping(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+{
+}
+
+bool MappedFile::open(const std::string &path)
+{
+    close();
+
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        close();
+        return false;
+    }
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        close();
+        return false;
+    }
+    mapping = static_cast<const std::uint8_t *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!mapping) {
+        close();
+        return false;
+    }
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mapping) {
+        UnmapViewOfFile(mapping);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+    }
+    mapping = nullptr;
+    length = 0;
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+}
+
+void MappedFile::adviseRandomAccess() const
+{
+    // Asked for when the file was opened
+}
+
+#else
+
+MappedFile::MappedFile()
+    : mapping(nullptr), length(0)
+{
+}
+
+bool MappedFile::open(const std::string &path)
+{
+    close();
+
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+        ::close(descriptor);
+        return false;
+    }
+
+    // The mapping keeps the file open by itself
+    void *address = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    mapping = static_cast<const std::uint8_t *>(address);
+    length = static_cast<std::size_t>(status.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mapping) {
+        munmap(const_cast<std::uint8_t *>(mapping), length);
+    }
+    mapping = nullptr;
+    length = 0;
+}
+
+void MappedFile::adviseRandomAccess() const
+{
+    if (mapping) {
+        madvise(const_cast<std::uint8_t *>(mapping), length, MADV_RANDOM);
+    }
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::isOpen() const
+{
+    return mapping != nullptr;
+}
+
+const std::uint8_t *MappedFile::data() const
+{
+    return mapping;
+}
+
+std::size_t MappedFile::size() const
+{
+    return length;
+}
@@ -0,0 +1,41 @@
+// mappedfile.h
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A whole file mapped read-only into memory (mmap on POSIX, a file mapping
+// on Windows). Pages are read from disk the first time they are touched,
+// and processes mapping the same file share them through the page cache.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Maps path, replacing any file mapped before; false if it cannot be
+    // opened or is empty
+    bool open(const std::string &path);
+    void close();
+
+    bool isOpen() const;
+    const std::uint8_t *data() const;
+    std::size_t size() const;
+
+    // Tells the OS that reads will be scattered, so it does not read ahead
+    void adviseRandomAccess() const;
+
+private:
+    const std::uint8_t *mapping;
+    std::size_t length;
+#if defined(_WIN32)
+    void *fileHandle;
+    void *mappingHandle;
+#endif
+};
+
+#endif // MAPPEDFILE_H
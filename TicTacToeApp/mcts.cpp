@@ -0,0 +1,305 @@
+// mcts.cpp
+#include "mcts.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Exploration weight of UCT for rewards between 0 and 1
+const double EXPLORATION = 1.4;
+
+// Playouts between two looks at the clock and the stop token
+const int CHECK_INTERVAL = 64;
+
+// xorshift64*; each thread has its own state
+inline std::uint64_t nextRandom(std::uint64_t &state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ull;
+}
+
+} // namespace
+
+template <int N, int K>
+BasicMctsEngine<N, K>::BasicMctsEngine(std::size_t nodeCapacity)
+    : capacity(nodeCapacity), used(0), limits(), threadCount(1), stats(),
+      rootBoard(), rootXToMove(true), playoutBudget(0), playouts(0), maxDepth(0), finished(false)
+{
+}
+
+template <int N, int K>
+EngineType BasicMctsEngine<N, K>::type() const
+{
+    return ENGINE_MCTS;
+}
+
+template <int N, int K>
+void BasicMctsEngine<N, K>::setSearchLimits(const SearchLimits &searchLimits)
+{
+    limits = searchLimits;
+}
+
+template <int N, int K>
+void BasicMctsEngine<N, K>::setThreadCount(int threads)
+{
+    threadCount = threads < 1 ? 1 : threads;
+}
+
+template <int N, int K>
+const MctsStats &BasicMctsEngine<N, K>::getStats() const
+{
+    return stats;
+}
+
+template <int N, int K>
+SearchResult BasicMctsEngine<N, K>::search(const Game &game, const StopToken &stop)
+{
+    SearchResult result = { -1, 0, 0, 0, false, false };
+    stats = MctsStats();
+    rootBoard = game.getBoard();
+    rootXToMove = (game.getCurrentPlayer() == PLAYER_X);
+    if (!Geometry::emptyCells(rootBoard) || game.checkGameStatus() != GAME_ONGOING) {
+        return result;
+    }
+
+    if (!arena) {
+        arena.reset(new Node[capacity]);
+    }
+    used = 1;
+    initNode(arena[0], -1, -1);
+    expand(arena[0], rootBoard, rootXToMove);
+
+    playoutBudget = limits.maxNodes > 0 ? limits.maxNodes : DEFAULT_PLAYOUTS;
+    if (limits.maxNodes == 0 && limits.timeLimitMs > 0) {
+        playoutBudget = std::numeric_limits<std::uint64_t>::max();
+    }
+    playouts = 0;
+    maxDepth = 0;
+    finished = false;
+    searchStart = std::chrono::steady_clock::now();
+
+    if (threadCount > 1) {
+        WorkStealingPool &helpers = pool.get(threadCount);
+        TaskGroup group;
+        for (int thread = 1; thread < threadCount; ++thread) {
+            helpers.submit(group, [this, thread, &stop]() {
+                runPlayouts(thread, stop);
+            });
+        }
+        runPlayouts(0, stop);
+        helpers.wait(group);
+    } else {
+        runPlayouts(0, stop);
+    }
+
+    // The most visited move is the most reliable; ties go to the lowest cell
+    const Node &root = arena[0];
+    int bestVisits = -1;
+    for (int i = 0; i < root.childCount; ++i) {
+        const Node &child = arena[root.firstChild + i];
+        if (child.visits > bestVisits) {
+            bestVisits = child.visits;
+            result.move = child.move;
+            double value = child.visits > 0 ? child.reward / (2.0 * child.visits) : 0.5;
+            int score = static_cast<int>(std::lround((2 * value - 1) * 100));
+            result.score = rootXToMove ? -score : score;
+        }
+    }
+
+    stats.playouts = std::min<std::uint64_t>(playouts, playoutBudget);
+    stats.treeNodes = std::min<std::size_t>(used, capacity);
+    stats.treeDepth = maxDepth;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - searchStart).count();
+    stats.playoutsPerSecond = stats.seconds > 0 ? stats.playouts / stats.seconds : 0;
+
+    result.depth = maxDepth;
+    result.nodes = stats.playouts;
+    result.stopped = stop.stopRequested();
+    return result;
+}
+
+template <int N, int K>
+void BasicMctsEngine<N, K>::initNode(Node &node, int move, int outcome)
+{
+    node.visits.store(0, std::memory_order_relaxed);
+    node.reward.store(0, std::memory_order_relaxed);
+    node.virtualLoss.store(0, std::memory_order_relaxed);
+    node.state.store(NODE_LEAF, std::memory_order_relaxed);
+    node.firstChild = 0;
+    node.childCount = 0;
+    node.move = move;
+    node.outcome = outcome;
+}
+
+template <int N, int K>
+bool BasicMctsEngine<N, K>::expand(Node &node, const Board &board, bool xToMove)
+{
+    // One thread grows a node; the others play out from it meanwhile
+    int expected = NODE_LEAF;
+    if (!node.state.compare_exchange_strong(expected, NODE_EXPANDING)) {
+        return false;
+    }
+
+    Mask empty = Geometry::emptyCells(board);
+    int count = bitCount(empty);
+    std::size_t first = used.fetch_add(count);
+    if (first + count > capacity) {
+        node.state.store(NODE_LEAF);
+        return false;
+    }
+
+    // A move that leaves neither side a line to complete draws, as does
+    // filling the last empty cell
+    Mask marks = xToMove ? board.x : board.o;
+    LineSet moverLines = Geometry::openLines(board, xToMove ? 0 : 1);
+    LineSet otherLines = Geometry::openLines(board, xToMove ? 1 : 0);
+    for (int i = 0; i < count; ++i) {
+        int move = popLowestBit(empty);
+        int outcome = -1;
+        if (Geometry::completesLine(Mask(marks | Geometry::bit(move)), move)) {
+            outcome = 2;
+        } else if (!(moverLines | (otherLines & ~Geometry::CELL_LINE_SETS[move]))) {
+            outcome = 1;
+        }
+        initNode(arena[first + i], move, outcome);
+    }
+    node.firstChild = static_cast<std::uint32_t>(first);
+    node.childCount = count;
+    node.state.store(NODE_EXPANDED, std::memory_order_release);
+    return true;
+}
+
+template <int N, int K>
+std::uint32_t BasicMctsEngine<N, K>::selectChild(const Node &node) const
+{
+    // Virtual losses count as visits that earned nothing
+    double parentVisits = node.visits.load(std::memory_order_relaxed)
+                          + node.virtualLoss.load(std::memory_order_relaxed) + 1;
+    double logParent = std::log(parentVisits);
+
+    std::uint32_t best = node.firstChild;
+    double bestValue = -1;
+    for (int i = 0; i < node.childCount; ++i) {
+        std::uint32_t index = node.firstChild + i;
+        const Node &child = arena[index];
+        int visits = child.visits.load(std::memory_order_relaxed)
+                     + child.virtualLoss.load(std::memory_order_relaxed);
+        if (visits == 0) {
+            return index;
+        }
+        double value = child.reward.load(std::memory_order_relaxed) / (2.0 * visits)
+                       + EXPLORATION * std::sqrt(logParent / visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = index;
+        }
+    }
+    return best;
+}
+
+template <int N, int K>
+void BasicMctsEngine<N, K>::runPlayouts(int thread, const StopToken &stop)
+{
+    std::uint64_t random = 0x9E3779B97F4A7C15ull * (thread + 1);
+    for (int done = 1; !finished.load(std::memory_order_relaxed); ++done) {
+        if (playouts.fetch_add(1, std::memory_order_relaxed) >= playoutBudget) {
+            finished = true;
+            break;
+        }
+        playOnce(random);
+
+        if (done % CHECK_INTERVAL == 0) {
+            if (stop.stopRequested()) {
+                finished = true;
+            }
+            if (limits.timeLimitMs > 0
+                && std::chrono::steady_clock::now() - searchStart >= std::chrono::milliseconds(limits.timeLimitMs)) {
+                finished = true;
+            }
+        }
+    }
+}
+
+template <int N, int K>
+void BasicMctsEngine<N, K>::playOnce(std::uint64_t &random)
+{
+    // The side that moved into path[i] is X when rootXToMove == (i is odd)
+    std::uint32_t path[Game::CELL_COUNT + 1];
+    int length = 0;
+    path[0] = 0;
+    Board board = rootBoard;
+    bool xToMove = rootXToMove;
+    int winner; // 1 for X, 2 for O, 0 for a draw
+
+    for (;;) {
+        Node &node = arena[path[length]];
+        if (node.outcome >= 0) {
+            bool moverIsX = !xToMove;
+            winner = node.outcome == 1 ? 0 : (moverIsX ? 1 : 2);
+            break;
+        }
+        // A leaf is played out on its first visit and grows children on the next
+        if (node.state.load(std::memory_order_acquire) != NODE_EXPANDED) {
+            if (node.visits.load(std::memory_order_relaxed) == 0 || !expand(node, board, xToMove)) {
+                winner = playout(board, xToMove, random);
+                break;
+            }
+        }
+
+        std::uint32_t index = selectChild(node);
+        Node &child = arena[index];
+        child.virtualLoss.fetch_add(1, std::memory_order_relaxed);
+        (xToMove ? board.x : board.o) |= Geometry::bit(child.move);
+        xToMove = !xToMove;
+        path[++length] = index;
+    }
+
+    for (int i = length; i >= 0; --i) {
+        Node &node = arena[path[i]];
+        bool moverIsX = (rootXToMove == (i % 2 == 1));
+        int reward = winner == 0 ? 1 : ((winner == 1) == moverIsX ? 2 : 0);
+        node.reward.fetch_add(reward, std::memory_order_relaxed);
+        node.visits.fetch_add(1, std::memory_order_relaxed);
+        if (i > 0) {
+            node.virtualLoss.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    int deepest = maxDepth.load(std::memory_order_relaxed);
+    while (length > deepest && !maxDepth.compare_exchange_weak(deepest, length)) {
+    }
+}
+
+template <int N, int K>
+int BasicMctsEngine<N, K>::playout(Board board, bool xToMove, std::uint64_t &random) const
+{
+    // Uniformly random moves until a line is completed or none can be
+    Mask empty = Geometry::emptyCells(board);
+    LineSet open[2] = { Geometry::openLines(board, 0), Geometry::openLines(board, 1) };
+    while (empty && (open[0] | open[1])) {
+        int count = bitCount(empty);
+        int skip = static_cast<int>(((nextRandom(random) >> 32) * count) >> 32);
+        Mask cells = empty;
+        while (skip-- > 0) {
+            cells &= cells - 1;
+        }
+        int cell = lowestBit(cells);
+        Mask bit = Geometry::bit(cell);
+        empty &= ~bit;
+
+        Mask &marks = xToMove ? board.x : board.o;
+        marks |= bit;
+        if (Geometry::completesLine(marks, cell)) {
+            return xToMove ? 1 : 2;
+        }
+        open[xToMove ? 1 : 0] &= ~Geometry::CELL_LINE_SETS[cell];
+        xToMove = !xToMove;
+    }
+    return 0;
+}
+
+template class BasicMctsEngine<3, 3>;
+template class BasicMctsEngine<4, 4>;
+template class BasicMctsEngine<5, 4>;
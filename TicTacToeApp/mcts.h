@@ -0,0 +1,102 @@
+// mcts.h
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "engine.h"
+#include "workstealingpool.h"
+
+struct MctsStats
+{
+    std::uint64_t playouts;
+    std::uint64_t treeNodes;
+    int treeDepth;
+    double seconds;
+    double playoutsPerSecond;
+};
+
+// Monte Carlo tree search with UCT selection, for boards that alpha-beta
+// cannot search out. All threads grow one tree (tree parallelism); a
+// thread adds a virtual loss to every node on its path so the others
+// spread to different lines until its playout is backed up. The helper
+// threads are a pool started by the first search and kept for the next.
+//
+// Nodes live in a fixed arena allocated on first use and reused for every
+// search. When it is full the tree stops growing and playouts start from
+// its leaves. Limits: maxNodes caps the playouts, timeLimitMs the time;
+// maxDepth is ignored. Without either, a search runs DEFAULT_PLAYOUTS.
+// A finished game, even one with empty cells left, gets no move.
+// The score is the best move's expected result from O's point of view,
+// from -100 (O always loses) to 100 (O always wins).
+template <int N, int K>
+class BasicMctsEngine : public BasicEngine<N, K>
+{
+public:
+    typedef BasicGameLogic<N, K> Game;
+    typedef BoardGeometry<N, K> Geometry;
+    typedef typename Geometry::Mask Mask;
+    typedef typename Geometry::Board Board;
+    typedef typename Geometry::LineSet LineSet;
+
+    static constexpr std::uint64_t DEFAULT_PLAYOUTS = 100000;
+
+    explicit BasicMctsEngine(std::size_t nodeCapacity = 1 << 20);
+
+    EngineType type() const override;
+    void setSearchLimits(const SearchLimits &limits) override;
+    void setThreadCount(int threads) override;
+    SearchResult search(const Game &game, const StopToken &stop) override;
+
+    const MctsStats &getStats() const; // Of the last search
+
+private:
+    enum NodeState { NODE_LEAF, NODE_EXPANDING, NODE_EXPANDED };
+
+    // Rewards count half-points for the side whose move led to the node:
+    // 2 for a win, 1 for a draw
+    struct Node
+    {
+        std::atomic<int> visits;
+        std::atomic<int> reward;
+        std::atomic<int> virtualLoss;
+        std::atomic<int> state;
+        std::uint32_t firstChild;
+        int childCount;
+        int move;
+        int outcome; // Reward of a finished game, -1 while it goes on
+    };
+
+    std::unique_ptr<Node[]> arena;
+    std::size_t capacity;
+    std::atomic<std::size_t> used;
+
+    SearchLimits limits;
+    int threadCount;
+    ReusablePool pool;
+    MctsStats stats;
+
+    Board rootBoard;
+    bool rootXToMove;
+    std::uint64_t playoutBudget;
+    std::chrono::steady_clock::time_point searchStart;
+    std::atomic<std::uint64_t> playouts;
+    std::atomic<int> maxDepth;
+    std::atomic<bool> finished;
+
+    void initNode(Node &node, int move, int outcome);
+    bool expand(Node &node, const Board &board, bool xToMove);
+    std::uint32_t selectChild(const Node &node) const;
+    void runPlayouts(int thread, const StopToken &stop);
+    void playOnce(std::uint64_t &random);
+    int playout(Board board, bool xToMove, std::uint64_t &random) const;
+};
+
+extern template class BasicMctsEngine<3, 3>;
+extern template class BasicMctsEngine<4, 4>;
+extern template class BasicMctsEngine<5, 4>;
+
+#endif // MCTS_H
@@ -0,0 +1,31 @@
+// movelist.h
+#ifndef MOVELIST_H
+#define MOVELIST_H
+
+#include "bitboard.h"
+
+// The moves of one node in the order they are searched. It lives on the
+// stack, so the search allocates nothing once its table is set up.
+template <int Capacity>
+struct MoveList
+{
+    int count;
+    signed char moves[Capacity];
+};
+
+// firstMove (when it is one of the moves) followed by the others, lowest cell first
+template <int Capacity, typename Mask>
+inline void generateMoves(MoveList<Capacity> &list, Mask moves, int firstMove)
+{
+    list.count = 0;
+    Mask first = firstMove >= 0 ? Mask(Mask(1) << firstMove) : Mask(0);
+    if (moves & first) {
+        list.moves[list.count++] = static_cast<signed char>(firstMove);
+        moves &= ~first;
+    }
+    while (moves) {
+        list.moves[list.count++] = static_cast<signed char>(popLowestBit(moves));
+    }
+}
+
+#endif // MOVELIST_H
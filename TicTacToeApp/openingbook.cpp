@@ -0,0 +1,245 @@
+// openingbook.cpp
+#include "openingbook.h"
+#include "gamelogic.h"
+#include "symmetry.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+namespace {
+
+// Plays board's marks onto an empty game, X and O in turn. Every prefix
+// holds a subset of the marks, so none of them ends the game early.
+template <int N, int K>
+void setUpPosition(BasicGameLogic<N, K> &game, const typename BoardGeometry<N, K>::Board &board)
+{
+    typedef typename BoardGeometry<N, K>::Mask Mask;
+    Mask x = board.x;
+    Mask o = board.o;
+    game.resetGame();
+    while (x) {
+        game.makeMove(popLowestBit(x));
+        if (o) {
+            game.makeMove(popLowestBit(o));
+        }
+    }
+}
+
+} // namespace
+
+std::uint64_t openingBookChecksum(const std::uint64_t *entries, std::size_t count)
+{
+    const std::uint8_t *data = reinterpret_cast<const std::uint8_t *>(entries);
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < count * sizeof(std::uint64_t); ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+template <int N, int K>
+BasicOpeningBook<N, K>::BasicOpeningBook()
+    : entries(nullptr), entryCount(0), plyCount(0), checksum(0)
+{
+}
+
+template <int N, int K>
+bool BasicOpeningBook<N, K>::load(const std::string &path)
+{
+    entries = nullptr;
+    entryCount = 0;
+    if (!file.open(path) || file.size() < sizeof(OpeningBookHeader)) {
+        file.close();
+        return false;
+    }
+    OpeningBookHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    bool valid = std::memcmp(header.magic, OPENING_BOOK_MAGIC, sizeof(header.magic)) == 0
+            && header.version == OPENING_BOOK_VERSION && header.headerSize == sizeof(OpeningBookHeader)
+            && header.boardSize == N && header.winLength == K
+            && header.entryCount == (file.size() - sizeof(OpeningBookHeader)) / sizeof(std::uint64_t)
+            && (file.size() - sizeof(OpeningBookHeader)) % sizeof(std::uint64_t) == 0;
+    if (!valid) {
+        file.close();
+        return false;
+    }
+
+    // The mapping is page-aligned and the header a multiple of 8 bytes
+    entries = reinterpret_cast<const std::uint64_t *>(file.data() + sizeof(OpeningBookHeader));
+    entryCount = header.entryCount;
+    plyCount = header.plies;
+    checksum = header.checksum;
+    return true;
+}
+
+template <int N, int K>
+bool BasicOpeningBook<N, K>::loadEmbedded()
+{
+    EmbeddedOpeningBook book = embeddedOpeningBook<N, K>();
+    if (!book.entries) {
+        return false;
+    }
+    file.close();
+    entries = book.entries;
+    entryCount = book.entryCount;
+    plyCount = book.plies;
+    checksum = book.checksum;
+    return true;
+}
+
+template <int N, int K>
+bool BasicOpeningBook<N, K>::isLoaded() const
+{
+    return entries != nullptr;
+}
+
+template <int N, int K>
+bool BasicOpeningBook<N, K>::verify() const
+{
+    return isLoaded() && std::is_sorted(entries, entries + entryCount)
+            && openingBookChecksum(entries, entryCount) == checksum;
+}
+
+template <int N, int K>
+std::size_t BasicOpeningBook<N, K>::size() const
+{
+    return entryCount;
+}
+
+template <int N, int K>
+int BasicOpeningBook<N, K>::plies() const
+{
+    return plyCount;
+}
+
+template <int N, int K>
+int BasicOpeningBook<N, K>::probe(const Board &board) const
+{
+    if (!isLoaded() || bitCount(typename Geometry::Mask(board.x | board.o)) >= plyCount) {
+        return -1;
+    }
+    int symmetry;
+    std::uint64_t key = positionKey(canonicalBoard<N>(board, &symmetry));
+    const std::uint64_t *end = entries + entryCount;
+    const std::uint64_t *entry = std::lower_bound(entries, end, packBookEntry(key, 0));
+    if (entry == end || bookEntryKey(*entry) != key) {
+        return -1;
+    }
+    return SYMMETRY<N>.inverseCells[symmetry][bookEntryMove(*entry)];
+}
+
+template <int N, int K>
+std::uint64_t BasicOpeningBook<N, K>::positionKey(const Board &canonical)
+{
+    return (std::uint64_t(canonical.x) << Geometry::CELLS) | std::uint64_t(canonical.o);
+}
+
+template <int N, int K>
+std::vector<std::uint64_t> generateOpeningBook(int plies, std::uint64_t maxNodes, const StopToken &stop,
+                                               const std::function<void(std::size_t, std::size_t)> &positionDone)
+{
+    typedef BoardGeometry<N, K> Geometry;
+    typedef typename Geometry::Mask Mask;
+    typedef typename Geometry::Board Board;
+    typedef BasicOpeningBook<N, K> Book;
+
+    // Every unfinished position of the first plies, one per symmetry class,
+    // a layer of equal mark counts at a time
+    std::vector<Board> positions;
+    std::vector<Board> layer(1, Board { 0, 0 });
+    for (int marks = 0; marks < plies && !layer.empty(); ++marks) {
+        positions.insert(positions.end(), layer.begin(), layer.end());
+        std::set<std::uint64_t> seen;
+        std::vector<Board> next;
+        for (const Board &board : layer) {
+            int side = marks % 2;
+            Mask cells = Geometry::emptyCells(board);
+            while (cells) {
+                int cell = popLowestBit(cells);
+                Board child = board;
+                Mask &own = side ? child.o : child.x;
+                own |= Geometry::bit(cell);
+                if (Geometry::completesLine(own, cell)
+                        || (!Geometry::openLines(child, 0) && !Geometry::openLines(child, 1))) {
+                    continue;
+                }
+                Board canonical = canonicalBoard<N>(child);
+                if (seen.insert(Book::positionKey(canonical)).second) {
+                    next.push_back(canonical);
+                }
+            }
+        }
+        layer.swap(next);
+    }
+
+    // One engine throughout, so each search starts from the table the
+    // searches before it filled
+    BasicGameLogic<N, K> game;
+    SearchLimits limits = { 0, 0, maxNodes };
+    game.setSearchLimits(limits);
+    std::vector<std::uint64_t> entries;
+    entries.reserve(positions.size());
+    for (const Board &board : positions) {
+        if (stop.stopRequested()) {
+            return std::vector<std::uint64_t>();
+        }
+        setUpPosition<N, K>(game, board);
+        int move = maxNodes ? game.search(stop).move : game.getBestMoveBySearch();
+        entries.push_back(packBookEntry(Book::positionKey(board), move));
+        if (positionDone) {
+            positionDone(entries.size(), positions.size());
+        }
+    }
+    if (stop.stopRequested()) {
+        return std::vector<std::uint64_t>();
+    }
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+template <int N, int K>
+bool writeOpeningBook(const std::string &path, const std::vector<std::uint64_t> &entries, int plies, bool solved)
+{
+    OpeningBookHeader header = {};
+    std::memcpy(header.magic, OPENING_BOOK_MAGIC, sizeof(header.magic));
+    header.version = OPENING_BOOK_VERSION;
+    header.headerSize = sizeof(OpeningBookHeader);
+    header.boardSize = N;
+    header.winLength = K;
+    header.plies = static_cast<std::uint8_t>(plies);
+    header.solved = solved ? 1 : 0;
+    header.entryCount = entries.size();
+    header.checksum = openingBookChecksum(entries.data(), entries.size());
+
+    // Written aside and renamed over the old file, which stays intact for
+    // whoever has it mapped
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(std::uint64_t));
+        if (!file.flush()) {
+            return false;
+        }
+    }
+#if defined(_WIN32)
+    std::remove(path.c_str());
+#endif
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+template class BasicOpeningBook<3, 3>;
+template class BasicOpeningBook<4, 4>;
+template class BasicOpeningBook<5, 4>;
+template std::vector<std::uint64_t> generateOpeningBook<3, 3>(int, std::uint64_t, const StopToken &,
+                                                              const std::function<void(std::size_t, std::size_t)> &);
+template std::vector<std::uint64_t> generateOpeningBook<4, 4>(int, std::uint64_t, const StopToken &,
+                                                              const std::function<void(std::size_t, std::size_t)> &);
+template std::vector<std::uint64_t> generateOpeningBook<5, 4>(int, std::uint64_t, const StopToken &,
+                                                              const std::function<void(std::size_t, std::size_t)> &);
+template bool writeOpeningBook<3, 3>(const std::string &, const std::vector<std::uint64_t> &, int, bool);
+template bool writeOpeningBook<4, 4>(const std::string &, const std::vector<std::uint64_t> &, int, bool);
+template bool writeOpeningBook<5, 4>(const std::string &, const std::vector<std::uint64_t> &, int, bool);
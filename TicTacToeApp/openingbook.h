@@ -0,0 +1,143 @@
+// openingbook.h
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "bitboard.h"
+#include "mappedfile.h"
+#include "stoptoken.h"
+
+// One entry per position, up to symmetry: the position's key in the high
+// bits and the move for the side to move in the low byte. Both are taken in
+// the canonical orientation, and entries sorted by value are sorted by key.
+// Keys are the canonical x marks above the canonical o marks, so a 5x5 entry
+// still fits 64 bits.
+inline std::uint64_t packBookEntry(std::uint64_t key, int move)
+{
+    return (key << 8) | static_cast<std::uint8_t>(move);
+}
+
+inline std::uint64_t bookEntryKey(std::uint64_t entry)
+{
+    return entry >> 8;
+}
+
+inline int bookEntryMove(std::uint64_t entry)
+{
+    return static_cast<int>(entry & 0xFF);
+}
+
+// Opening book file layout, integers little-endian: the header, then
+// entryCount 64-bit entries in ascending order. The checksum is FNV-1a over
+// the entries.
+const char OPENING_BOOK_MAGIC[8] = { 'T', 'T', 'T', 'B', 'O', 'O', 'K', 0 };
+const std::uint32_t OPENING_BOOK_VERSION = 1;
+
+struct OpeningBookHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint8_t boardSize;
+    std::uint8_t winLength;
+    std::uint8_t plies;     // Positions with fewer marks than this are in the book
+    std::uint8_t solved;    // 1 if every move was searched to the end of the game
+    std::uint8_t reserved[4];
+    std::uint64_t entryCount;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(OpeningBookHeader) == 40, "the header layout is part of the file format");
+
+std::uint64_t openingBookChecksum(const std::uint64_t *entries, std::size_t count);
+
+// Book compiled into the program; no entries for boards without one
+struct EmbeddedOpeningBook
+{
+    const std::uint64_t *entries;
+    std::size_t entryCount;
+    int plies;
+    std::uint64_t checksum;
+};
+
+// 4x4 has one, written by TicTacToeBook into openingbook4x4.cpp. 3x3 needs
+// none: perfectplay.cpp already answers every position at compile time.
+template <int N, int K>
+EmbeddedOpeningBook embeddedOpeningBook()
+{
+    return { nullptr, 0, 0, 0 };
+}
+
+template <>
+EmbeddedOpeningBook embeddedOpeningBook<4, 4>();
+
+// The AI's moves for every position of the first plies of a game, looked
+// up by binary search over the sorted entries. The entries are either a
+// mapped book file or an array compiled into the program.
+template <int N, int K>
+class BasicOpeningBook
+{
+public:
+    typedef BoardGeometry<N, K> Geometry;
+    typedef typename Geometry::Board Board;
+
+    BasicOpeningBook();
+
+    // False if the file is missing, of another version or board, or its
+    // size does not match its entry count
+    bool load(const std::string &path);
+    // The book compiled into the program; false if this board has none
+    bool loadEmbedded();
+    bool isLoaded() const;
+
+    // Reads every entry to compare the checksum and the order; not done by load()
+    bool verify() const;
+
+    std::size_t size() const;
+    int plies() const;
+
+    // Move for the side to move, -1 when the position is not in the book
+    int probe(const Board &board) const;
+
+    static std::uint64_t positionKey(const Board &canonical);
+
+private:
+    MappedFile file;
+    const std::uint64_t *entries;
+    std::size_t entryCount;
+    int plyCount;
+    std::uint64_t checksum;
+};
+
+// Finds every position of the first plies (fewer marks than plies) that
+// can arise in play, up to symmetry, and searches the move for each:
+// to the end of the game when maxNodes is 0, otherwise within that many
+// nodes per position. positionDone is called with the count searched so
+// far and the total. Returns the sorted entries, empty when stopped.
+template <int N, int K>
+std::vector<std::uint64_t> generateOpeningBook(int plies, std::uint64_t maxNodes, const StopToken &stop = StopToken(),
+                                               const std::function<void(std::size_t done, std::size_t total)>
+                                                       &positionDone = std::function<void(std::size_t, std::size_t)>());
+
+// Writes entries as a book file, replacing any old one in a single rename
+template <int N, int K>
+bool writeOpeningBook(const std::string &path, const std::vector<std::uint64_t> &entries, int plies, bool solved);
+
+extern template class BasicOpeningBook<3, 3>;
+extern template class BasicOpeningBook<4, 4>;
+extern template class BasicOpeningBook<5, 4>;
+extern template std::vector<std::uint64_t> generateOpeningBook<3, 3>(int, std::uint64_t, const StopToken &,
+                                                                     const std::function<void(std::size_t, std::size_t)> &);
+extern template std::vector<std::uint64_t> generateOpeningBook<4, 4>(int, std::uint64_t, const StopToken &,
+                                                                     const std::function<void(std::size_t, std::size_t)> &);
+extern template std::vector<std::uint64_t> generateOpeningBook<5, 4>(int, std::uint64_t, const StopToken &,
+                                                                     const std::function<void(std::size_t, std::size_t)> &);
+extern template bool writeOpeningBook<3, 3>(const std::string &, const std::vector<std::uint64_t> &, int, bool);
+extern template bool writeOpeningBook<4, 4>(const std::string &, const std::vector<std::uint64_t> &, int, bool);
+extern template bool writeOpeningBook<5, 4>(const std::string &, const std::vector<std::uint64_t> &, int, bool);
+
+#endif // OPENINGBOOK_H
@@ -0,0 +1,434 @@
+// openingbook4x4.cpp
+// Generated by TicTacToeBook 4x4 5; do not edit.
+#include "openingbook.h"
+
+namespace {
+
+const std::uint64_t ENTRIES[] = {
+    0x0000000000000000ull, 0x0000000001000001ull, 0x0000000001000202ull, 0x0000000001000401ull,
+    0x0000000001000801ull, 0x0000000001002001ull, 0x0000000001004001ull, 0x0000000001008001ull,
+    0x0000000001040001ull, 0x0000000001080001ull, 0x0000000001800001ull, 0x0000000002000000ull,
+    0x0000000002000102ull, 0x0000000002000400ull, 0x0000000002000800ull, 0x0000000002001000ull,
+    0x0000000002002000ull, 0x0000000002004000ull, 0x0000000002008000ull, 0x0000000002010000ull,
+    0x0000000002020000ull, 0x0000000002040000ull, 0x0000000002080000ull, 0x0000000002100000ull,
+    0x0000000002200000ull, 0x0000000002400000ull, 0x0000000002800000ull, 0x0000000003000403ull,
+    0x0000000003000802ull, 0x0000000003000c04ull, 0x0000000003001002ull, 0x0000000003001403ull,
+    0x0000000003001802ull, 0x0000000003002002ull, 0x0000000003002403ull, 0x0000000003002802ull,
+    0x0000000003003002ull, 0x0000000003004002ull, 0x0000000003004403ull, 0x0000000003004802ull,
+    0x0000000003005002ull, 0x0000000003006002ull, 0x0000000003008002ull, 0x0000000003008403ull,
+    0x0000000003008802ull, 0x0000000003009002ull, 0x000000000300a002ull, 0x000000000300c002ull,
+    0x0000000003010002ull, 0x0000000003010403ull, 0x0000000003010802ull, 0x0000000003011002ull,
+    0x0000000003012002ull, 0x0000000003014002ull, 0x0000000003018002ull, 0x0000000003020002ull,
+    0x0000000003020403ull, 0x0000000003020802ull, 0x0000000003021002ull, 0x0000000003022002ull,
+    0x0000000003024002ull, 0x0000000003028002ull, 0x0000000003030002ull, 0x0000000003040002ull,
+    0x0000000003040403ull, 0x0000000003040802ull, 0x0000000003041002ull, 0x0000000003042002ull,
+    0x0000000003044002ull, 0x0000000003048002ull, 0x0000000003050002ull, 0x0000000003060002ull,
+    0x0000000003080002ull, 0x0000000003080403ull, 0x0000000003080802ull, 0x0000000003081002ull,
+    0x0000000003082002ull, 0x0000000003084002ull, 0x0000000003088002ull, 0x0000000003090002ull,
+    0x00000000030a0002ull, 0x00000000030c0002ull, 0x0000000003100002ull, 0x0000000003100403ull,
+    0x0000000003100802ull, 0x0000000003101002ull, 0x0000000003102002ull, 0x0000000003104002ull,
+    0x0000000003108002ull, 0x0000000003110002ull, 0x0000000003120002ull, 0x0000000003140002ull,
+    0x0000000003180002ull, 0x0000000003200002ull, 0x0000000003200403ull, 0x0000000003200802ull,
+    0x0000000003201002ull, 0x0000000003202002ull, 0x0000000003204002ull, 0x0000000003208002ull,
+    0x0000000003210002ull, 0x0000000003220002ull, 0x0000000003240002ull, 0x0000000003280002ull,
+    0x0000000003300002ull, 0x0000000003400002ull, 0x0000000003400403ull, 0x0000000003400802ull,
+    0x0000000003401002ull, 0x0000000003402002ull, 0x0000000003404002ull, 0x0000000003408002ull,
+    0x0000000003410002ull, 0x0000000003420002ull, 0x0000000003440002ull, 0x0000000003480002ull,
+    0x0000000003500002ull, 0x0000000003600002ull, 0x0000000003800002ull, 0x0000000003800403ull,
+    0x0000000003800802ull, 0x0000000003801002ull, 0x0000000003802002ull, 0x0000000003804002ull,
+    0x0000000003808002ull, 0x0000000003810002ull, 0x0000000003820002ull, 0x0000000003840002ull,
+    0x0000000003880002ull, 0x0000000003900002ull, 0x0000000003a00002ull, 0x0000000003c00002ull,
+    0x0000000005000203ull, 0x0000000005000801ull, 0x0000000005000a04ull, 0x0000000005001001ull,
+    0x0000000005001203ull, 0x0000000005001801ull, 0x0000000005002001ull, 0x0000000005002203ull,
+    0x0000000005002801ull, 0x0000000005003001ull, 0x0000000005004001ull, 0x0000000005004203ull,
+    0x0000000005004801ull, 0x0000000005005001ull, 0x0000000005006001ull, 0x0000000005008001ull,
+    0x0000000005008203ull, 0x0000000005008801ull, 0x0000000005009001ull, 0x000000000500a001ull,
+    0x000000000500c001ull, 0x0000000005010001ull, 0x0000000005010203ull, 0x0000000005010801ull,
+    0x0000000005011001ull, 0x0000000005012001ull, 0x0000000005014001ull, 0x0000000005018001ull,
+    0x0000000005020001ull, 0x0000000005020203ull, 0x0000000005020801ull, 0x0000000005021001ull,
+    0x0000000005022001ull, 0x0000000005024001ull, 0x0000000005028001ull, 0x0000000005030001ull,
+    0x0000000005040001ull, 0x0000000005040203ull, 0x0000000005040801ull, 0x0000000005041001ull,
+    0x0000000005042001ull, 0x0000000005044001ull, 0x0000000005048001ull, 0x0000000005050001ull,
+    0x0000000005060001ull, 0x0000000005080001ull, 0x0000000005080203ull, 0x0000000005080801ull,
+    0x0000000005081001ull, 0x0000000005082001ull, 0x0000000005084001ull, 0x0000000005088001ull,
+    0x0000000005090001ull, 0x00000000050a0001ull, 0x00000000050c0001ull, 0x0000000005100001ull,
+    0x0000000005100203ull, 0x0000000005100801ull, 0x0000000005101001ull, 0x0000000005102001ull,
+    0x0000000005104001ull, 0x0000000005108001ull, 0x0000000005110001ull, 0x0000000005120001ull,
+    0x0000000005140001ull, 0x0000000005180001ull, 0x0000000005200001ull, 0x0000000005200203ull,
+    0x0000000005200801ull, 0x0000000005201001ull, 0x0000000005202001ull, 0x0000000005204001ull,
+    0x0000000005208001ull, 0x0000000005210001ull, 0x0000000005220001ull, 0x0000000005240001ull,
+    0x0000000005280001ull, 0x0000000005300001ull, 0x0000000005400001ull, 0x0000000005400203ull,
+    0x0000000005400801ull, 0x0000000005401001ull, 0x0000000005402001ull, 0x0000000005404001ull,
+    0x0000000005408001ull, 0x0000000005410001ull, 0x0000000005420001ull, 0x0000000005440001ull,
+    0x0000000005480001ull, 0x0000000005500001ull, 0x0000000005600001ull, 0x0000000005800001ull,
+    0x0000000005800203ull, 0x0000000005800801ull, 0x0000000005801001ull, 0x0000000005802001ull,
+    0x0000000005804001ull, 0x0000000005808001ull, 0x0000000005810001ull, 0x0000000005820001ull,
+    0x0000000005840001ull, 0x0000000005880001ull, 0x0000000005900001ull, 0x0000000005a00001ull,
+    0x0000000005c00001ull, 0x0000000006000103ull, 0x0000000006000904ull, 0x0000000006001000ull,
+    0x0000000006001103ull, 0x0000000006001800ull, 0x0000000006002000ull, 0x0000000006002103ull,
+    0x0000000006002800ull, 0x0000000006003000ull, 0x0000000006005000ull, 0x0000000006006000ull,
+    0x0000000006009000ull, 0x0000000006010000ull, 0x0000000006010103ull, 0x0000000006010800ull,
+    0x0000000006011000ull, 0x0000000006012000ull, 0x0000000006014000ull, 0x0000000006018000ull,
+    0x0000000006020000ull, 0x0000000006020103ull, 0x0000000006020800ull, 0x0000000006021000ull,
+    0x0000000006022000ull, 0x0000000006024000ull, 0x0000000006028000ull, 0x0000000006030000ull,
+    0x0000000006050000ull, 0x0000000006060000ull, 0x0000000006090000ull, 0x0000000006100000ull,
+    0x0000000006100103ull, 0x0000000006100800ull, 0x0000000006101000ull, 0x0000000006102000ull,
+    0x0000000006104000ull, 0x0000000006108000ull, 0x0000000006110000ull, 0x0000000006120000ull,
+    0x0000000006140000ull, 0x0000000006180000ull, 0x0000000006200000ull, 0x0000000006200103ull,
+    0x0000000006200800ull, 0x0000000006201000ull, 0x0000000006202000ull, 0x0000000006204000ull,
+    0x0000000006208000ull, 0x0000000006210000ull, 0x0000000006220000ull, 0x0000000006240000ull,
+    0x0000000006280000ull, 0x0000000006300000ull, 0x0000000006500000ull, 0x0000000006600000ull,
+    0x0000000006900000ull, 0x0000000009000202ull, 0x0000000009000604ull, 0x0000000009001001ull,
+    0x0000000009001202ull, 0x0000000009001401ull, 0x0000000009002001ull, 0x0000000009002202ull,
+    0x0000000009002401ull, 0x0000000009003001ull, 0x0000000009005001ull, 0x0000000009006001ull,
+    0x0000000009009001ull, 0x0000000009010001ull, 0x0000000009010202ull, 0x0000000009010401ull,
+    0x0000000009011001ull, 0x0000000009012001ull, 0x0000000009014001ull, 0x0000000009018001ull,
+    0x0000000009020001ull, 0x0000000009020202ull, 0x0000000009020401ull, 0x0000000009021001ull,
+    0x0000000009022001ull, 0x0000000009024001ull, 0x0000000009028001ull, 0x0000000009030001ull,
+    0x0000000009050001ull, 0x0000000009060001ull, 0x0000000009090001ull, 0x0000000009100001ull,
+    0x0000000009100202ull, 0x0000000009100401ull, 0x0000000009101001ull, 0x0000000009102001ull,
+    0x0000000009104001ull, 0x0000000009108001ull, 0x0000000009110001ull, 0x0000000009120001ull,
+    0x0000000009140001ull, 0x0000000009180001ull, 0x0000000009200001ull, 0x0000000009200202ull,
+    0x0000000009200401ull, 0x0000000009201001ull, 0x0000000009202001ull, 0x0000000009204001ull,
+    0x0000000009208001ull, 0x0000000009210001ull, 0x0000000009220001ull, 0x0000000009240001ull,
+    0x0000000009280001ull, 0x0000000009300001ull, 0x0000000009500001ull, 0x0000000009600001ull,
+    0x0000000009900001ull, 0x0000000012000102ull, 0x0000000012000400ull, 0x0000000012000503ull,
+    0x0000000012000800ull, 0x0000000012000902ull, 0x0000000012000c00ull, 0x0000000012002000ull,
+    0x0000000012002102ull, 0x0000000012002400ull, 0x0000000012002800ull, 0x0000000012004000ull,
+    0x0000000012004102ull, 0x0000000012004400ull, 0x0000000012004800ull, 0x0000000012006000ull,
+    0x0000000012008000ull, 0x0000000012008102ull, 0x0000000012008400ull, 0x0000000012008800ull,
+    0x000000001200a000ull, 0x000000001200c000ull, 0x0000000012010400ull, 0x0000000012010800ull,
+    0x0000000012014000ull, 0x0000000012018000ull, 0x0000000012020800ull, 0x0000000012024000ull,
+    0x0000000012028000ull, 0x0000000012040000ull, 0x0000000012040102ull, 0x0000000012040400ull,
+    0x0000000012040800ull, 0x0000000012042000ull, 0x0000000012044000ull, 0x0000000012048000ull,
+    0x0000000012080000ull, 0x0000000012080102ull, 0x0000000012080400ull, 0x0000000012080800ull,
+    0x0000000012082000ull, 0x0000000012084000ull, 0x0000000012088000ull, 0x0000000012090000ull,
+    0x00000000120a0000ull, 0x00000000120c0000ull, 0x0000000012100800ull, 0x0000000012108000ull,
+    0x0000000012180000ull, 0x0000000012208000ull, 0x0000000012280000ull, 0x0000000012480000ull,
+    0x0000000012800000ull, 0x0000000012800102ull, 0x0000000012800400ull, 0x0000000012800800ull,
+    0x0000000012802000ull, 0x0000000012804000ull, 0x0000000012808000ull, 0x0000000012840000ull,
+    0x0000000012880000ull, 0x0000000014000101ull, 0x0000000014000200ull, 0x0000000014000303ull,
+    0x0000000014000800ull, 0x0000000014000901ull, 0x0000000014000a00ull, 0x0000000014002000ull,
+    0x0000000014002101ull, 0x0000000014002200ull, 0x0000000014002800ull, 0x0000000014004000ull,
+    0x0000000014004101ull, 0x0000000014004200ull, 0x0000000014004800ull, 0x0000000014006000ull,
+    0x0000000014008000ull, 0x0000000014008101ull, 0x0000000014008200ull, 0x0000000014008800ull,
+    0x000000001400a000ull, 0x000000001400c000ull, 0x0000000014010000ull, 0x0000000014010101ull,
+    0x0000000014010200ull, 0x0000000014010800ull, 0x0000000014012000ull, 0x0000000014014000ull,
+    0x0000000014018000ull, 0x0000000014020000ull, 0x0000000014020101ull, 0x0000000014020200ull,
+    0x0000000014020800ull, 0x0000000014022000ull, 0x0000000014024000ull, 0x0000000014028000ull,
+    0x0000000014030000ull, 0x0000000014040000ull, 0x0000000014040101ull, 0x0000000014040200ull,
+    0x0000000014040800ull, 0x0000000014042000ull, 0x0000000014044000ull, 0x0000000014048000ull,
+    0x0000000014050000ull, 0x0000000014060000ull, 0x0000000014080000ull, 0x0000000014080101ull,
+    0x0000000014080200ull, 0x0000000014080800ull, 0x0000000014082000ull, 0x0000000014084000ull,
+    0x0000000014088000ull, 0x0000000014090000ull, 0x00000000140a0000ull, 0x00000000140c0000ull,
+    0x0000000014100000ull, 0x0000000014100101ull, 0x0000000014100200ull, 0x0000000014100800ull,
+    0x0000000014102000ull, 0x0000000014104000ull, 0x0000000014108000ull, 0x0000000014110000ull,
+    0x0000000014120000ull, 0x0000000014140000ull, 0x0000000014180000ull, 0x0000000014200000ull,
+    0x0000000014200101ull, 0x0000000014200200ull, 0x0000000014200800ull, 0x0000000014202000ull,
+    0x0000000014204000ull, 0x0000000014208000ull, 0x0000000014210000ull, 0x0000000014220000ull,
+    0x0000000014240000ull, 0x0000000014280000ull, 0x0000000014300000ull, 0x0000000014400000ull,
+    0x0000000014400101ull, 0x0000000014400200ull, 0x0000000014400800ull, 0x0000000014402000ull,
+    0x0000000014404000ull, 0x0000000014408000ull, 0x0000000014410000ull, 0x0000000014420000ull,
+    0x0000000014440000ull, 0x0000000014480000ull, 0x0000000014500000ull, 0x0000000014600000ull,
+    0x0000000014800000ull, 0x0000000014800101ull, 0x0000000014800200ull, 0x0000000014800800ull,
+    0x0000000014802000ull, 0x0000000014804000ull, 0x0000000014808000ull, 0x0000000014810000ull,
+    0x0000000014820000ull, 0x0000000014840000ull, 0x0000000014880000ull, 0x0000000014900000ull,
+    0x0000000014a00000ull, 0x0000000014c00000ull, 0x0000000018000101ull, 0x0000000018000200ull,
+    0x0000000018000302ull, 0x0000000018000400ull, 0x0000000018000501ull, 0x0000000018000600ull,
+    0x0000000018002000ull, 0x0000000018002101ull, 0x0000000018002200ull, 0x0000000018002400ull,
+    0x0000000018004000ull, 0x0000000018004101ull, 0x0000000018004200ull, 0x0000000018004400ull,
+    0x0000000018006000ull, 0x0000000018008000ull, 0x0000000018008101ull, 0x0000000018008200ull,
+    0x0000000018008400ull, 0x000000001800a000ull, 0x000000001800c000ull, 0x0000000018010000ull,
+    0x0000000018010101ull, 0x0000000018010200ull, 0x0000000018010400ull, 0x0000000018012000ull,
+    0x0000000018014000ull, 0x0000000018018000ull, 0x0000000018020000ull, 0x0000000018020101ull,
+    0x0000000018020200ull, 0x0000000018020400ull, 0x0000000018022000ull, 0x0000000018024000ull,
+    0x0000000018028000ull, 0x0000000018030000ull, 0x0000000018040000ull, 0x0000000018040101ull,
+    0x0000000018040200ull, 0x0000000018040400ull, 0x0000000018042000ull, 0x0000000018044000ull,
+    0x0000000018048000ull, 0x0000000018050000ull, 0x0000000018060000ull, 0x0000000018080000ull,
+    0x0000000018080101ull, 0x0000000018080200ull, 0x0000000018080400ull, 0x0000000018082000ull,
+    0x0000000018084000ull, 0x0000000018088000ull, 0x0000000018090000ull, 0x00000000180a0000ull,
+    0x00000000180c0000ull, 0x0000000018100000ull, 0x0000000018100101ull, 0x0000000018100200ull,
+    0x0000000018100400ull, 0x0000000018102000ull, 0x0000000018104000ull, 0x0000000018108000ull,
+    0x0000000018110000ull, 0x0000000018120000ull, 0x0000000018140000ull, 0x0000000018180000ull,
+    0x0000000018200000ull, 0x0000000018200101ull, 0x0000000018200200ull, 0x0000000018200400ull,
+    0x0000000018202000ull, 0x0000000018204000ull, 0x0000000018208000ull, 0x0000000018210000ull,
+    0x0000000018220000ull, 0x0000000018240000ull, 0x0000000018280000ull, 0x0000000018300000ull,
+    0x0000000018400000ull, 0x0000000018400101ull, 0x0000000018400200ull, 0x0000000018400400ull,
+    0x0000000018402000ull, 0x0000000018404000ull, 0x0000000018408000ull, 0x0000000018410000ull,
+    0x0000000018420000ull, 0x0000000018440000ull, 0x0000000018480000ull, 0x0000000018500000ull,
+    0x0000000018600000ull, 0x0000000018800000ull, 0x0000000018800101ull, 0x0000000018800200ull,
+    0x0000000018800400ull, 0x0000000018802000ull, 0x0000000018804000ull, 0x0000000018808000ull,
+    0x0000000018810000ull, 0x0000000018820000ull, 0x0000000018840000ull, 0x0000000018880000ull,
+    0x0000000018900000ull, 0x0000000018a00000ull, 0x0000000018c00000ull, 0x0000000020000000ull,
+    0x0000000020000101ull, 0x0000000020000200ull, 0x0000000020000400ull, 0x0000000020000800ull,
+    0x0000000020004000ull, 0x0000000020008000ull, 0x0000000020040000ull, 0x0000000020080000ull,
+    0x0000000020800000ull, 0x0000000021000202ull, 0x0000000021000401ull, 0x0000000021000603ull,
+    0x0000000021000801ull, 0x0000000021000a02ull, 0x0000000021000c01ull, 0x0000000021001202ull,
+    0x0000000021001401ull, 0x0000000021001801ull, 0x0000000021004001ull, 0x0000000021004202ull,
+    0x0000000021004401ull, 0x0000000021004801ull, 0x0000000021005001ull, 0x0000000021008001ull,
+    0x0000000021008202ull, 0x0000000021008401ull, 0x0000000021008801ull, 0x0000000021009001ull,
+    0x000000002100c001ull, 0x0000000021010401ull, 0x0000000021010801ull, 0x0000000021014001ull,
+    0x0000000021018001ull, 0x0000000021020801ull, 0x0000000021024001ull, 0x0000000021028001ull,
+    0x0000000021040001ull, 0x0000000021040202ull, 0x0000000021040401ull, 0x0000000021040801ull,
+    0x0000000021044001ull, 0x0000000021048001ull, 0x0000000021080001ull, 0x0000000021080202ull,
+    0x0000000021080401ull, 0x0000000021080801ull, 0x0000000021081001ull, 0x0000000021084001ull,
+    0x0000000021088001ull, 0x0000000021090001ull, 0x00000000210a0001ull, 0x00000000210c0001ull,
+    0x0000000021100801ull, 0x0000000021108001ull, 0x0000000021180001ull, 0x0000000021208001ull,
+    0x0000000021280001ull, 0x0000000021480001ull, 0x0000000021800001ull, 0x0000000021800202ull,
+    0x0000000021800401ull, 0x0000000021800801ull, 0x0000000021804001ull, 0x0000000021808001ull,
+    0x0000000021840001ull, 0x0000000021880001ull, 0x0000000022000102ull, 0x0000000022000400ull,
+    0x0000000022000503ull, 0x0000000022000800ull, 0x0000000022000902ull, 0x0000000022000c00ull,
+    0x0000000022001000ull, 0x0000000022001102ull, 0x0000000022001400ull, 0x0000000022001800ull,
+    0x0000000022004000ull, 0x0000000022004102ull, 0x0000000022004400ull, 0x0000000022004800ull,
+    0x0000000022005000ull, 0x0000000022008000ull, 0x0000000022008102ull, 0x0000000022008400ull,
+    0x0000000022008800ull, 0x0000000022009000ull, 0x000000002200c000ull, 0x0000000022010000ull,
+    0x0000000022010102ull, 0x0000000022010400ull, 0x0000000022010800ull, 0x0000000022011000ull,
+    0x0000000022014000ull, 0x0000000022018000ull, 0x0000000022020000ull, 0x0000000022020102ull,
+    0x0000000022020400ull, 0x0000000022020800ull, 0x0000000022021000ull, 0x0000000022024000ull,
+    0x0000000022028000ull, 0x0000000022030000ull, 0x0000000022040000ull, 0x0000000022040102ull,
+    0x0000000022040400ull, 0x0000000022040800ull, 0x0000000022041000ull, 0x0000000022044000ull,
+    0x0000000022048000ull, 0x0000000022050000ull, 0x0000000022060000ull, 0x0000000022080000ull,
+    0x0000000022080102ull, 0x0000000022080400ull, 0x0000000022080800ull, 0x0000000022081000ull,
+    0x0000000022084000ull, 0x0000000022088000ull, 0x0000000022090000ull, 0x00000000220a0000ull,
+    0x00000000220c0000ull, 0x0000000022100000ull, 0x0000000022100102ull, 0x0000000022100400ull,
+    0x0000000022100800ull, 0x0000000022101000ull, 0x0000000022104000ull, 0x0000000022108000ull,
+    0x0000000022110000ull, 0x0000000022120000ull, 0x0000000022140000ull, 0x0000000022180000ull,
+    0x0000000022200000ull, 0x0000000022200102ull, 0x0000000022200400ull, 0x0000000022200800ull,
+    0x0000000022201000ull, 0x0000000022204000ull, 0x0000000022208000ull, 0x0000000022210000ull,
+    0x0000000022220000ull, 0x0000000022240000ull, 0x0000000022280000ull, 0x0000000022300000ull,
+    0x0000000022400000ull, 0x0000000022400102ull, 0x0000000022400400ull, 0x0000000022400800ull,
+    0x0000000022401000ull, 0x0000000022404000ull, 0x0000000022408000ull, 0x0000000022410000ull,
+    0x0000000022420000ull, 0x0000000022440000ull, 0x0000000022480000ull, 0x0000000022500000ull,
+    0x0000000022600000ull, 0x0000000022800000ull, 0x0000000022800102ull, 0x0000000022800400ull,
+    0x0000000022800800ull, 0x0000000022801000ull, 0x0000000022804000ull, 0x0000000022808000ull,
+    0x0000000022810000ull, 0x0000000022820000ull, 0x0000000022840000ull, 0x0000000022880000ull,
+    0x0000000022900000ull, 0x0000000022a00000ull, 0x0000000022c00000ull, 0x0000000024000101ull,
+    0x0000000024000200ull, 0x0000000024000303ull, 0x0000000024000800ull, 0x0000000024000901ull,
+    0x0000000024000a00ull, 0x0000000024001000ull, 0x0000000024001101ull, 0x0000000024001200ull,
+    0x0000000024001800ull, 0x0000000024004000ull, 0x0000000024004101ull, 0x0000000024004200ull,
+    0x0000000024004800ull, 0x0000000024005000ull, 0x0000000024008000ull, 0x0000000024008101ull,
+    0x0000000024008200ull, 0x0000000024008800ull, 0x0000000024009000ull, 0x000000002400c000ull,
+    0x0000000024010000ull, 0x0000000024010101ull, 0x0000000024010200ull, 0x0000000024010800ull,
+    0x0000000024011000ull, 0x0000000024014000ull, 0x0000000024018000ull, 0x0000000024020000ull,
+    0x0000000024020101ull, 0x0000000024020200ull, 0x0000000024020800ull, 0x0000000024021000ull,
+    0x0000000024024000ull, 0x0000000024028000ull, 0x0000000024030000ull, 0x0000000024040000ull,
+    0x0000000024040101ull, 0x0000000024040200ull, 0x0000000024040800ull, 0x0000000024041000ull,
+    0x0000000024044000ull, 0x0000000024048000ull, 0x0000000024050000ull, 0x0000000024060000ull,
+    0x0000000024080000ull, 0x0000000024080101ull, 0x0000000024080200ull, 0x0000000024080800ull,
+    0x0000000024081000ull, 0x0000000024084000ull, 0x0000000024088000ull, 0x0000000024090000ull,
+    0x00000000240a0000ull, 0x00000000240c0000ull, 0x0000000024100000ull, 0x0000000024100101ull,
+    0x0000000024100200ull, 0x0000000024100800ull, 0x0000000024101000ull, 0x0000000024104000ull,
+    0x0000000024108000ull, 0x0000000024110000ull, 0x0000000024120000ull, 0x0000000024140000ull,
+    0x0000000024180000ull, 0x0000000024200000ull, 0x0000000024200101ull, 0x0000000024200200ull,
+    0x0000000024200800ull, 0x0000000024201000ull, 0x0000000024204000ull, 0x0000000024208000ull,
+    0x0000000024210000ull, 0x0000000024220000ull, 0x0000000024240000ull, 0x0000000024280000ull,
+    0x0000000024300000ull, 0x0000000024400000ull, 0x0000000024400101ull, 0x0000000024400200ull,
+    0x0000000024400800ull, 0x0000000024401000ull, 0x0000000024404000ull, 0x0000000024408000ull,
+    0x0000000024410000ull, 0x0000000024420000ull, 0x0000000024440000ull, 0x0000000024480000ull,
+    0x0000000024500000ull, 0x0000000024600000ull, 0x0000000024800000ull, 0x0000000024800101ull,
+    0x0000000024800200ull, 0x0000000024800800ull, 0x0000000024801000ull, 0x0000000024804000ull,
+    0x0000000024808000ull, 0x0000000024810000ull, 0x0000000024820000ull, 0x0000000024840000ull,
+    0x0000000024880000ull, 0x0000000024900000ull, 0x0000000024a00000ull, 0x0000000024c00000ull,
+    0x0000000028000101ull, 0x0000000028000200ull, 0x0000000028000302ull, 0x0000000028000400ull,
+    0x0000000028000501ull, 0x0000000028000600ull, 0x0000000028001000ull, 0x0000000028001101ull,
+    0x0000000028001200ull, 0x0000000028001400ull, 0x0000000028004000ull, 0x0000000028004101ull,
+    0x0000000028004200ull, 0x0000000028004400ull, 0x0000000028005000ull, 0x0000000028008000ull,
+    0x0000000028008101ull, 0x0000000028008200ull, 0x0000000028008400ull, 0x0000000028009000ull,
+    0x000000002800c000ull, 0x0000000028010000ull, 0x0000000028010101ull, 0x0000000028010200ull,
+    0x0000000028010400ull, 0x0000000028011000ull, 0x0000000028014000ull, 0x0000000028018000ull,
+    0x0000000028020000ull, 0x0000000028020101ull, 0x0000000028020200ull, 0x0000000028020400ull,
+    0x0000000028021000ull, 0x0000000028024000ull, 0x0000000028028000ull, 0x0000000028030000ull,
+    0x0000000028040000ull, 0x0000000028040101ull, 0x0000000028040200ull, 0x0000000028040400ull,
+    0x0000000028041000ull, 0x0000000028044000ull, 0x0000000028048000ull, 0x0000000028050000ull,
+    0x0000000028060000ull, 0x0000000028080000ull, 0x0000000028080101ull, 0x0000000028080200ull,
+    0x0000000028080400ull, 0x0000000028081000ull, 0x0000000028084000ull, 0x0000000028088000ull,
+    0x0000000028090000ull, 0x00000000280a0000ull, 0x00000000280c0000ull, 0x0000000028100000ull,
+    0x0000000028100101ull, 0x0000000028100200ull, 0x0000000028100400ull, 0x0000000028101000ull,
+    0x0000000028104000ull, 0x0000000028108000ull, 0x0000000028110000ull, 0x0000000028120000ull,
+    0x0000000028140000ull, 0x0000000028180000ull, 0x0000000028200000ull, 0x0000000028200101ull,
+    0x0000000028200200ull, 0x0000000028200400ull, 0x0000000028201000ull, 0x0000000028204000ull,
+    0x0000000028208000ull, 0x0000000028210000ull, 0x0000000028220000ull, 0x0000000028240000ull,
+    0x0000000028280000ull, 0x0000000028300000ull, 0x0000000028400000ull, 0x0000000028400101ull,
+    0x0000000028400200ull, 0x0000000028400400ull, 0x0000000028401000ull, 0x0000000028404000ull,
+    0x0000000028408000ull, 0x0000000028410000ull, 0x0000000028420000ull, 0x0000000028440000ull,
+    0x0000000028480000ull, 0x0000000028500000ull, 0x0000000028600000ull, 0x0000000028800000ull,
+    0x0000000028800101ull, 0x0000000028800200ull, 0x0000000028800400ull, 0x0000000028801000ull,
+    0x0000000028804000ull, 0x0000000028808000ull, 0x0000000028810000ull, 0x0000000028820000ull,
+    0x0000000028840000ull, 0x0000000028880000ull, 0x0000000028900000ull, 0x0000000028a00000ull,
+    0x0000000028c00000ull, 0x0000000050000101ull, 0x0000000050000200ull, 0x0000000050000302ull,
+    0x0000000050000400ull, 0x0000000050000501ull, 0x0000000050000600ull, 0x0000000050000800ull,
+    0x0000000050000901ull, 0x0000000050000a00ull, 0x0000000050000c00ull, 0x0000000050002000ull,
+    0x0000000050002101ull, 0x0000000050002200ull, 0x0000000050002400ull, 0x0000000050002800ull,
+    0x0000000050008000ull, 0x0000000050008101ull, 0x0000000050008200ull, 0x0000000050008400ull,
+    0x0000000050008800ull, 0x000000005000a000ull, 0x0000000050010000ull, 0x0000000050010101ull,
+    0x0000000050010200ull, 0x0000000050010400ull, 0x0000000050010800ull, 0x0000000050012000ull,
+    0x0000000050018000ull, 0x0000000050020000ull, 0x0000000050020101ull, 0x0000000050020200ull,
+    0x0000000050020400ull, 0x0000000050020800ull, 0x0000000050022000ull, 0x0000000050028000ull,
+    0x0000000050030000ull, 0x0000000050040000ull, 0x0000000050040101ull, 0x0000000050040200ull,
+    0x0000000050040400ull, 0x0000000050040800ull, 0x0000000050042000ull, 0x0000000050048000ull,
+    0x0000000050050000ull, 0x0000000050060000ull, 0x0000000050080000ull, 0x0000000050080101ull,
+    0x0000000050080200ull, 0x0000000050080400ull, 0x0000000050080800ull, 0x0000000050082000ull,
+    0x0000000050088000ull, 0x0000000050090000ull, 0x00000000500a0000ull, 0x00000000500c0000ull,
+    0x0000000050100000ull, 0x0000000050100101ull, 0x0000000050100200ull, 0x0000000050100400ull,
+    0x0000000050100800ull, 0x0000000050102000ull, 0x0000000050108000ull, 0x0000000050110000ull,
+    0x0000000050120000ull, 0x0000000050140000ull, 0x0000000050180000ull, 0x0000000050200000ull,
+    0x0000000050200101ull, 0x0000000050200200ull, 0x0000000050200400ull, 0x0000000050200800ull,
+    0x0000000050202000ull, 0x0000000050208000ull, 0x0000000050210000ull, 0x0000000050220000ull,
+    0x0000000050240000ull, 0x0000000050280000ull, 0x0000000050300000ull, 0x0000000050400000ull,
+    0x0000000050400101ull, 0x0000000050400200ull, 0x0000000050400400ull, 0x0000000050400800ull,
+    0x0000000050402000ull, 0x0000000050408000ull, 0x0000000050410000ull, 0x0000000050420000ull,
+    0x0000000050440000ull, 0x0000000050480000ull, 0x0000000050500000ull, 0x0000000050600000ull,
+    0x0000000050800000ull, 0x0000000050800101ull, 0x0000000050800200ull, 0x0000000050800400ull,
+    0x0000000050800800ull, 0x0000000050802000ull, 0x0000000050808000ull, 0x0000000050810000ull,
+    0x0000000050820000ull, 0x0000000050840000ull, 0x0000000050880000ull, 0x0000000050900000ull,
+    0x0000000050a00000ull, 0x0000000050c00000ull, 0x0000000060000101ull, 0x0000000060000200ull,
+    0x0000000060000302ull, 0x0000000060000501ull, 0x0000000060000600ull, 0x0000000060000901ull,
+    0x0000000060001000ull, 0x0000000060001101ull, 0x0000000060001200ull, 0x0000000060001400ull,
+    0x0000000060001800ull, 0x0000000060009000ull, 0x0000000060010000ull, 0x0000000060010101ull,
+    0x0000000060010200ull, 0x0000000060010400ull, 0x0000000060010800ull, 0x0000000060011000ull,
+    0x0000000060018000ull, 0x0000000060020000ull, 0x0000000060020101ull, 0x0000000060020200ull,
+    0x0000000060020400ull, 0x0000000060020800ull, 0x0000000060021000ull, 0x0000000060028000ull,
+    0x0000000060030000ull, 0x0000000060050000ull, 0x0000000060060000ull, 0x0000000060090000ull,
+    0x0000000060100000ull, 0x0000000060100101ull, 0x0000000060100200ull, 0x0000000060100400ull,
+    0x0000000060100800ull, 0x0000000060101000ull, 0x0000000060108000ull, 0x0000000060110000ull,
+    0x0000000060120000ull, 0x0000000060140000ull, 0x0000000060180000ull, 0x0000000060200000ull,
+    0x0000000060200101ull, 0x0000000060200200ull, 0x0000000060200400ull, 0x0000000060200800ull,
+    0x0000000060201000ull, 0x0000000060208000ull, 0x0000000060210000ull, 0x0000000060220000ull,
+    0x0000000060240000ull, 0x0000000060280000ull, 0x0000000060300000ull, 0x0000000060500000ull,
+    0x0000000060600000ull, 0x0000000060900000ull, 0x0000000090000101ull, 0x0000000090000200ull,
+    0x0000000090000302ull, 0x0000000090000501ull, 0x0000000090000600ull, 0x0000000090000901ull,
+    0x0000000090002000ull, 0x0000000090002101ull, 0x0000000090002200ull, 0x0000000090002400ull,
+    0x0000000090002800ull, 0x0000000090006000ull, 0x0000000090010000ull, 0x0000000090010101ull,
+    0x0000000090010200ull, 0x0000000090010400ull, 0x0000000090010800ull, 0x0000000090012000ull,
+    0x0000000090014000ull, 0x0000000090020000ull, 0x0000000090020101ull, 0x0000000090020200ull,
+    0x0000000090020400ull, 0x0000000090020800ull, 0x0000000090022000ull, 0x0000000090024000ull,
+    0x0000000090030000ull, 0x0000000090050000ull, 0x0000000090060000ull, 0x0000000090090000ull,
+    0x0000000090100000ull, 0x0000000090100101ull, 0x0000000090100200ull, 0x0000000090100400ull,
+    0x0000000090100800ull, 0x0000000090102000ull, 0x0000000090104000ull, 0x0000000090110000ull,
+    0x0000000090120000ull, 0x0000000090140000ull, 0x0000000090180000ull, 0x0000000090200000ull,
+    0x0000000090200101ull, 0x0000000090200200ull, 0x0000000090200400ull, 0x0000000090200800ull,
+    0x0000000090202000ull, 0x0000000090204000ull, 0x0000000090210000ull, 0x0000000090220000ull,
+    0x0000000090240000ull, 0x0000000090280000ull, 0x0000000090300000ull, 0x0000000090500000ull,
+    0x0000000090600000ull, 0x0000000090900000ull, 0x0000000104000101ull, 0x0000000104000200ull,
+    0x0000000104000303ull, 0x0000000104000800ull, 0x0000000104000901ull, 0x0000000104000a00ull,
+    0x0000000104001200ull, 0x0000000104001800ull, 0x0000000104002000ull, 0x0000000104002101ull,
+    0x0000000104002200ull, 0x0000000104002800ull, 0x0000000104004000ull, 0x0000000104004101ull,
+    0x0000000104004200ull, 0x0000000104004800ull, 0x0000000104005000ull, 0x0000000104006000ull,
+    0x0000000104008000ull, 0x0000000104008101ull, 0x0000000104008200ull, 0x0000000104008800ull,
+    0x0000000104009000ull, 0x000000010400a000ull, 0x000000010400c000ull, 0x0000000104020800ull,
+    0x0000000104024000ull, 0x0000000104028000ull, 0x0000000104040000ull, 0x0000000104040101ull,
+    0x0000000104040200ull, 0x0000000104040800ull, 0x0000000104042000ull, 0x0000000104044000ull,
+    0x0000000104048000ull, 0x0000000104080000ull, 0x0000000104080101ull, 0x0000000104080200ull,
+    0x0000000104080800ull, 0x0000000104081000ull, 0x0000000104082000ull, 0x0000000104084000ull,
+    0x0000000104088000ull, 0x00000001040a0000ull, 0x00000001040c0000ull, 0x0000000104100800ull,
+    0x0000000104108000ull, 0x0000000104180000ull, 0x0000000104208000ull, 0x0000000104280000ull,
+    0x0000000104480000ull, 0x0000000104800000ull, 0x0000000104800101ull, 0x0000000104800200ull,
+    0x0000000104800800ull, 0x0000000104802000ull, 0x0000000104804000ull, 0x0000000104808000ull,
+    0x0000000104840000ull, 0x0000000104880000ull, 0x0000000108000101ull, 0x0000000108000200ull,
+    0x0000000108000302ull, 0x0000000108000400ull, 0x0000000108000501ull, 0x0000000108000600ull,
+    0x0000000108001000ull, 0x0000000108001101ull, 0x0000000108001200ull, 0x0000000108001400ull,
+    0x0000000108002000ull, 0x0000000108002101ull, 0x0000000108002200ull, 0x0000000108002400ull,
+    0x0000000108003000ull, 0x0000000108004000ull, 0x0000000108004101ull, 0x0000000108004200ull,
+    0x0000000108004400ull, 0x0000000108005000ull, 0x0000000108006000ull, 0x0000000108008000ull,
+    0x0000000108008101ull, 0x0000000108008200ull, 0x0000000108008400ull, 0x0000000108009000ull,
+    0x000000010800a000ull, 0x000000010800c000ull, 0x0000000108020000ull, 0x0000000108020101ull,
+    0x0000000108020200ull, 0x0000000108020400ull, 0x0000000108021000ull, 0x0000000108022000ull,
+    0x0000000108024000ull, 0x0000000108028000ull, 0x0000000108040000ull, 0x0000000108040101ull,
+    0x0000000108040200ull, 0x0000000108040400ull, 0x0000000108041000ull, 0x0000000108042000ull,
+    0x0000000108044000ull, 0x0000000108048000ull, 0x0000000108060000ull, 0x0000000108080000ull,
+    0x0000000108080101ull, 0x0000000108080200ull, 0x0000000108080400ull, 0x0000000108081000ull,
+    0x0000000108082000ull, 0x0000000108084000ull, 0x0000000108088000ull, 0x00000001080a0000ull,
+    0x00000001080c0000ull, 0x0000000108100000ull, 0x0000000108100101ull, 0x0000000108100200ull,
+    0x0000000108100400ull, 0x0000000108101000ull, 0x0000000108102000ull, 0x0000000108104000ull,
+    0x0000000108108000ull, 0x0000000108120000ull, 0x0000000108140000ull, 0x0000000108180000ull,
+    0x0000000108200000ull, 0x0000000108200101ull, 0x0000000108200200ull, 0x0000000108200400ull,
+    0x0000000108201000ull, 0x0000000108202000ull, 0x0000000108204000ull, 0x0000000108208000ull,
+    0x0000000108220000ull, 0x0000000108240000ull, 0x0000000108280000ull, 0x0000000108300000ull,
+    0x0000000108400000ull, 0x0000000108400101ull, 0x0000000108400200ull, 0x0000000108400400ull,
+    0x0000000108401000ull, 0x0000000108402000ull, 0x0000000108404000ull, 0x0000000108408000ull,
+    0x0000000108420000ull, 0x0000000108440000ull, 0x0000000108480000ull, 0x0000000108500000ull,
+    0x0000000108600000ull, 0x0000000108800000ull, 0x0000000108800101ull, 0x0000000108800200ull,
+    0x0000000108800400ull, 0x0000000108801000ull, 0x0000000108802000ull, 0x0000000108804000ull,
+    0x0000000108808000ull, 0x0000000108820000ull, 0x0000000108840000ull, 0x0000000108880000ull,
+    0x0000000108900000ull, 0x0000000108a00000ull, 0x0000000108c00000ull, 0x0000000140000101ull,
+    0x0000000140000200ull, 0x0000000140000302ull, 0x0000000140000400ull, 0x0000000140000501ull,
+    0x0000000140000600ull, 0x0000000140000800ull, 0x0000000140000901ull, 0x0000000140000a00ull,
+    0x0000000140000c00ull, 0x0000000140001000ull, 0x0000000140001101ull, 0x0000000140001200ull,
+    0x0000000140001400ull, 0x0000000140001800ull, 0x0000000140002000ull, 0x0000000140002101ull,
+    0x0000000140002200ull, 0x0000000140002400ull, 0x0000000140002800ull, 0x0000000140003000ull,
+    0x0000000140008000ull, 0x0000000140008101ull, 0x0000000140008200ull, 0x0000000140008400ull,
+    0x0000000140008800ull, 0x0000000140009000ull, 0x000000014000a000ull, 0x0000000140020000ull,
+    0x0000000140020101ull, 0x0000000140020200ull, 0x0000000140020400ull, 0x0000000140020800ull,
+    0x0000000140021000ull, 0x0000000140022000ull, 0x0000000140028000ull, 0x0000000140040000ull,
+    0x0000000140040101ull, 0x0000000140040200ull, 0x0000000140040400ull, 0x0000000140040800ull,
+    0x0000000140041000ull, 0x0000000140042000ull, 0x0000000140048000ull, 0x0000000140060000ull,
+    0x0000000140080000ull, 0x0000000140080101ull, 0x0000000140080200ull, 0x0000000140080400ull,
+    0x0000000140080800ull, 0x0000000140081000ull, 0x0000000140082000ull, 0x0000000140088000ull,
+    0x00000001400a0000ull, 0x00000001400c0000ull, 0x0000000140100000ull, 0x0000000140100101ull,
+    0x0000000140100200ull, 0x0000000140100400ull, 0x0000000140100800ull, 0x0000000140101000ull,
+    0x0000000140102000ull, 0x0000000140108000ull, 0x0000000140120000ull, 0x0000000140140000ull,
+    0x0000000140180000ull, 0x0000000140200000ull, 0x0000000140200101ull, 0x0000000140200200ull,
+    0x0000000140200400ull, 0x0000000140200800ull, 0x0000000140201000ull, 0x0000000140202000ull,
+    0x0000000140208000ull, 0x0000000140220000ull, 0x0000000140240000ull, 0x0000000140280000ull,
+    0x0000000140300000ull, 0x0000000140400000ull, 0x0000000140400101ull, 0x0000000140400200ull,
+    0x0000000140400400ull, 0x0000000140400800ull, 0x0000000140401000ull, 0x0000000140402000ull,
+    0x0000000140408000ull, 0x0000000140420000ull, 0x0000000140440000ull, 0x0000000140480000ull,
+    0x0000000140500000ull, 0x0000000140600000ull, 0x0000000140800000ull, 0x0000000140800101ull,
+    0x0000000140800200ull, 0x0000000140800400ull, 0x0000000140800800ull, 0x0000000140801000ull,
+    0x0000000140802000ull, 0x0000000140808000ull, 0x0000000140820000ull, 0x0000000140840000ull,
+    0x0000000140880000ull, 0x0000000140900000ull, 0x0000000140a00000ull, 0x0000000140c00000ull,
+    0x0000000180000101ull, 0x0000000180000200ull, 0x0000000180000302ull, 0x0000000180000400ull,
+    0x0000000180000501ull, 0x0000000180000600ull, 0x0000000180000800ull, 0x0000000180000901ull,
+    0x0000000180000a00ull, 0x0000000180000c00ull, 0x0000000180001000ull, 0x0000000180001101ull,
+    0x0000000180001200ull, 0x0000000180001400ull, 0x0000000180001800ull, 0x0000000180002000ull,
+    0x0000000180002101ull, 0x0000000180002200ull, 0x0000000180002400ull, 0x0000000180002800ull,
+    0x0000000180003000ull, 0x0000000180004000ull, 0x0000000180004101ull, 0x0000000180004200ull,
+    0x0000000180004400ull, 0x0000000180004800ull, 0x0000000180005000ull, 0x0000000180006000ull,
+    0x0000000180020101ull, 0x0000000180020200ull, 0x0000000180020400ull, 0x0000000180020800ull,
+    0x0000000180021000ull, 0x0000000180022000ull, 0x0000000180024000ull, 0x0000000180040101ull,
+    0x0000000180040200ull, 0x0000000180040400ull, 0x0000000180040800ull, 0x0000000180041000ull,
+    0x0000000180042000ull, 0x0000000180080101ull, 0x0000000180080200ull, 0x0000000180080400ull,
+    0x0000000180080800ull, 0x0000000180081000ull, 0x0000000180100101ull, 0x0000000180100200ull,
+    0x0000000180100400ull, 0x0000000180100800ull, 0x0000000180200101ull, 0x0000000180200200ull,
+    0x0000000180200400ull, 0x0000000180400101ull, 0x0000000180400200ull, 0x0000000180800101ull,
+    0x0000000208000101ull, 0x0000000208000200ull, 0x0000000208000302ull, 0x0000000208000400ull,
+    0x0000000208000501ull, 0x0000000208000600ull, 0x0000000208001000ull, 0x0000000208001101ull,
+    0x0000000208001200ull, 0x0000000208001400ull, 0x0000000208002000ull, 0x0000000208002101ull,
+    0x0000000208002200ull, 0x0000000208002400ull, 0x0000000208003000ull, 0x0000000208004000ull,
+    0x0000000208004101ull, 0x0000000208004200ull, 0x0000000208004400ull, 0x0000000208005000ull,
+    0x0000000208006000ull, 0x0000000208008101ull, 0x0000000208008200ull, 0x0000000208008400ull,
+    0x0000000208009000ull, 0x000000020800a000ull, 0x0000000208010000ull, 0x0000000208010101ull,
+    0x0000000208010200ull, 0x0000000208010400ull, 0x0000000208011000ull, 0x0000000208012000ull,
+    0x0000000208014000ull, 0x0000000208018000ull, 0x0000000208040101ull, 0x0000000208040200ull,
+    0x0000000208041000ull, 0x0000000208042000ull, 0x0000000208050000ull, 0x0000000208080101ull,
+    0x0000000208080200ull, 0x0000000208081000ull, 0x0000000208090000ull, 0x0000000208100000ull,
+    0x0000000208100101ull, 0x0000000208100200ull, 0x0000000208100400ull, 0x0000000208101000ull,
+    0x0000000208102000ull, 0x0000000208104000ull, 0x0000000208110000ull, 0x0000000208200101ull,
+    0x0000000208201000ull, 0x0000000208210000ull, 0x0000000208400101ull, 0x0000000208401000ull,
+    0x0000000208800101ull, 0x0000000240000101ull, 0x0000000240000200ull, 0x0000000240000302ull,
+    0x0000000240000400ull, 0x0000000240000501ull, 0x0000000240000600ull, 0x0000000240000800ull,
+    0x0000000240000901ull, 0x0000000240000a00ull, 0x0000000240000c00ull, 0x0000000240001200ull,
+    0x0000000240001400ull, 0x0000000240001800ull, 0x0000000240002000ull, 0x0000000240002101ull,
+    0x0000000240002200ull, 0x0000000240002400ull, 0x0000000240002800ull, 0x0000000240008101ull,
+    0x0000000240008200ull, 0x0000000240008400ull, 0x0000000240009000ull, 0x000000024000a000ull,
+    0x0000000240010400ull, 0x0000000240010800ull, 0x0000000240018000ull, 0x0000000240040101ull,
+    0x0000000240040200ull, 0x0000000240042000ull, 0x0000000240080101ull, 0x0000000240080200ull,
+    0x0000000240081000ull, 0x0000000240100800ull, 0x0000000240800101ull, 0x0000001008000101ull,
+    0x0000001008000200ull, 0x0000001008000302ull, 0x0000001008000400ull, 0x0000001008000501ull,
+    0x0000001008000600ull, 0x0000001008001200ull, 0x0000001008001400ull, 0x0000001008002000ull,
+    0x0000001008002101ull, 0x0000001008002200ull, 0x0000001008002400ull, 0x0000001008004000ull,
+    0x0000001008004101ull, 0x0000001008004200ull, 0x0000001008004400ull, 0x0000001008005000ull,
+    0x0000001008006000ull, 0x0000001008008101ull, 0x0000001008008200ull, 0x0000001008008400ull,
+    0x0000001008009000ull, 0x000000100800a000ull, 0x0000001008010400ull, 0x0000001008014000ull,
+    0x0000001008018000ull, 0x0000001008024000ull, 0x0000001008040101ull, 0x0000001008040200ull,
+    0x0000001008042000ull, 0x0000001008080101ull, 0x0000001008080200ull, 0x0000001008081000ull,
+    0x0000001008800101ull,
+};
+
+} // namespace
+
+template <>
+EmbeddedOpeningBook embeddedOpeningBook<4, 4>()
+{
+    return { ENTRIES, sizeof(ENTRIES) / sizeof(ENTRIES[0]), 5, 0xa7760ef49ba93652ull };
+}
@@ -0,0 +1,114 @@
+// perfectplay.cpp
+#include "perfectplay.h"
+
+namespace {
+
+constexpr int BOARD_CELLS = Geometry3x3::CELLS;
+constexpr int FULL_BOARD = Geometry3x3::FULL;
+constexpr int POWERS_OF_THREE[BOARD_CELLS] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561 };
+
+// Sum of 3^i over the set bits of a mask, so rank = X digits + 2 * O digits
+struct RankTable
+{
+    unsigned short digits[FULL_BOARD + 1];
+};
+
+constexpr RankTable buildRankTable()
+{
+    RankTable table {};
+    for (int mask = 0; mask <= FULL_BOARD; ++mask) {
+        int digits = 0;
+        for (int cell = 0; cell < BOARD_CELLS; ++cell) {
+            if (mask & (1 << cell)) {
+                digits += POWERS_OF_THREE[cell];
+            }
+        }
+        table.digits[mask] = static_cast<unsigned short>(digits);
+    }
+    return table;
+}
+
+constexpr RankTable RANK_TABLE = buildRankTable();
+
+struct PerfectPlayTable
+{
+    signed char bestMove[POSITION_COUNT];
+};
+
+// Winner in evaluateBoard() order: 1 for X, 2 for O, 0 for none
+constexpr int winnerOf(int x, int o)
+{
+    for (int line : Geometry3x3::LINES) {
+        if ((x & line) == line) return 1;
+        if ((o & line) == line) return 2;
+    }
+    return 0;
+}
+
+constexpr int shrink(int score)
+{
+    return score > 0 ? score - 1 : (score < 0 ? score + 1 : 0);
+}
+
+// Backward induction over every encoding. Placing a mark only adds to the
+// rank, so walking ranks downwards always visits children before parents.
+// Scores are from the side to move's point of view, 10 for a win on the
+// spot, one point closer to zero per extra ply, matching minimax().
+constexpr PerfectPlayTable solvePerfectPlay()
+{
+    PerfectPlayTable table {};
+    signed char score[POSITION_COUNT] {};
+
+    for (int rank = POSITION_COUNT - 1; rank >= 0; --rank) {
+        int x = 0, o = 0, xCount = 0, oCount = 0;
+        for (int cell = 0, r = rank; cell < BOARD_CELLS; ++cell, r /= 3) {
+            if (r % 3 == 1) { x |= 1 << cell; ++xCount; }
+            if (r % 3 == 2) { o |= 1 << cell; ++oCount; }
+        }
+
+        table.bestMove[rank] = -1;
+        if (xCount != oCount && xCount != oCount + 1) {
+            continue; // Not a position either side can be asked to move in
+        }
+
+        bool xToMove = (xCount == oCount);
+        int winner = winnerOf(x, o);
+        if (winner != 0) {
+            score[rank] = (winner == 1) == xToMove ? 10 : -10;
+        }
+
+        // Even finished positions get a move, chosen exactly as the search would
+        int best = -1000;
+        for (int cell = 0; cell < BOARD_CELLS; ++cell) {
+            if ((x | o) & (1 << cell)) {
+                continue;
+            }
+            int child = rank + POWERS_OF_THREE[cell] * (xToMove ? 1 : 2);
+            int childScore = -score[child];
+            if (childScore > best) {
+                best = childScore;
+                table.bestMove[rank] = static_cast<signed char>(cell);
+            }
+        }
+
+        if (winner == 0) {
+            score[rank] = static_cast<signed char>(best == -1000 ? 0 : shrink(best));
+        }
+    }
+
+    return table;
+}
+
+constexpr PerfectPlayTable PERFECT_PLAY_TABLE = solvePerfectPlay();
+
+} // namespace
+
+int positionRank(const Geometry3x3::Board &board)
+{
+    return RANK_TABLE.digits[board.x] + 2 * RANK_TABLE.digits[board.o];
+}
+
+int perfectPlayMove(const Geometry3x3::Board &board)
+{
+    return PERFECT_PLAY_TABLE.bestMove[positionRank(board)];
+}
@@ -0,0 +1,20 @@
+// perfectplay.h
+#ifndef PERFECTPLAY_H
+#define PERFECTPLAY_H
+
+#include "bitboard.h"
+
+// The whole 3x3 game solved at compile time. A position's rank is its
+// base-3 encoding (digit i is 0 for empty, 1 for X, 2 for O on cell i).
+typedef BoardGeometry<3, 3> Geometry3x3;
+
+constexpr int POSITION_COUNT = 19683;
+
+int positionRank(const Geometry3x3::Board &board);
+
+// Best move for the side to move (X when both sides have the same number
+// of marks), with the same tie-breaking as the minimax search: the lowest
+// cell index among the best-scoring moves. Returns -1 on a full board.
+int perfectPlayMove(const Geometry3x3::Board &board);
+
+#endif // PERFECTPLAY_H
@@ -0,0 +1,169 @@
+// ponderer.cpp
+#include "ponderer.h"
+#include "movelist.h"
+#include "perfectplay.h"
+
+template <int N, int K>
+BasicPonderer<N, K>::BasicPonderer()
+    : limits(difficultySettings(DIFFICULTY_PERFECT).limits), difficulty(DIFFICULTY_PERFECT)
+{
+    replaceEngine(ENGINE_ALPHA_BETA);
+}
+
+template <int N, int K>
+BasicPonderer<N, K>::~BasicPonderer()
+{
+    stop();
+}
+
+template <int N, int K>
+void BasicPonderer<N, K>::setSearchLimits(const SearchLimits &searchLimits)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    stopThread();
+    limits = searchLimits;
+    engine->setSearchLimits(limits);
+}
+
+template <int N, int K>
+void BasicPonderer<N, K>::setDifficulty(Difficulty level)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    stopThread();
+    difficulty = level;
+    limits = difficultySettings(level).limits;
+    replaceEngine(engine->type());
+}
+
+template <int N, int K>
+Difficulty BasicPonderer<N, K>::getDifficulty() const
+{
+    return difficulty;
+}
+
+template <int N, int K>
+void BasicPonderer<N, K>::setEngineType(EngineType type)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    stopThread();
+    replaceEngine(type);
+}
+
+template <int N, int K>
+EngineType BasicPonderer<N, K>::getEngineType() const
+{
+    return engine->type();
+}
+
+template <int N, int K>
+void BasicPonderer<N, K>::start(const Game &game)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    stopThread();
+
+    pondered.copyPosition(game);
+    for (std::atomic<int> &answer : answers) {
+        answer = -1;
+    }
+    if (game.checkGameStatus() != GAME_ONGOING) {
+        return;
+    }
+    ponderStop = StopSource();
+    thread = std::thread(&BasicPonderer::ponder, this);
+}
+
+template <int N, int K>
+void BasicPonderer<N, K>::stop()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    stopThread();
+}
+
+template <int N, int K>
+void BasicPonderer<N, K>::stopThread()
+{
+    if (thread.joinable()) {
+        ponderStop.requestStop();
+        thread.join();
+    }
+}
+
+template <int N, int K>
+void BasicPonderer<N, K>::replaceEngine(EngineType type)
+{
+    // Cached answers came from the old engine
+    for (std::atomic<int> &answer : answers) {
+        answer = -1;
+    }
+    engine = makeEngine<N, K>(type);
+    engine->setDifficulty(difficulty);
+    engine->setSearchLimits(limits);
+}
+
+template <int N, int K>
+int BasicPonderer<N, K>::bestMove(const Game &game, const StopToken &stop)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    stopThread();
+
+    // A hit is the pondered position plus one mark of the human's, who was
+    // to move there, on a cell already searched
+    typedef typename Game::Mask Mask;
+    typename Game::Board before = pondered.getBoard();
+    typename Game::Board after = game.getBoard();
+    bool humanIsO = pondered.getCurrentPlayer() == PLAYER_O;
+    Mask humanBefore = humanIsO ? before.o : before.x;
+    Mask humanAfter = humanIsO ? after.o : after.x;
+    Mask aiBefore = humanIsO ? before.x : before.o;
+    Mask aiAfter = humanIsO ? after.x : after.o;
+    Mask reply = humanAfter & ~humanBefore;
+    if (aiAfter == aiBefore && (humanAfter & humanBefore) == humanBefore && bitCount(reply) == 1) {
+        int answer = answers[lowestBit(reply)];
+        if (answer >= 0) {
+            return answer;
+        }
+    }
+
+    return engine->bestMove(game, stop);
+}
+
+template <int N, int K>
+int BasicPonderer<N, K>::answeredReplies() const
+{
+    int count = 0;
+    for (const std::atomic<int> &answer : answers) {
+        count += (answer >= 0);
+    }
+    return count;
+}
+
+template <int N, int K>
+void BasicPonderer<N, K>::ponder()
+{
+    // On 3x3 the human's best reply is known; elsewhere replies go in cell order
+    typename Game::Board board = pondered.getBoard();
+    int predicted = -1;
+    if constexpr (N == 3 && K == 3) {
+        predicted = perfectPlayMove(board);
+    }
+    MoveList<Game::CELL_COUNT> replies;
+    generateMoves(replies, Game::Geometry::emptyCells(board), predicted);
+
+    StopToken stop = ponderStop.getToken();
+    for (int i = 0; i < replies.count && !stop.stopRequested(); ++i) {
+        int reply = replies.moves[i];
+        position.copyPosition(pondered);
+        position.makeMove(reply);
+        int answer = engine->bestMove(position, stop);
+
+        // An interrupted search has not finished its budget; leave it uncached
+        if (stop.stopRequested()) {
+            break;
+        }
+        answers[reply] = answer;
+    }
+}
+
+template class BasicPonderer<3, 3>;
+template class BasicPonderer<4, 4>;
+template class BasicPonderer<5, 4>;
@@ -0,0 +1,69 @@
+// ponderer.h
+#ifndef PONDERER_H
+#define PONDERER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "difficulty.h"
+#include "engine.h"
+#include "gamelogic.h"
+#include "stoptoken.h"
+
+// Thinks about the AI's next move while the human is choosing theirs.
+// start() searches the human's possible replies in the background, the
+// likely one first, and caches the AI's answer to each. bestMove() answers
+// at once when the human played a reply already searched, and otherwise
+// searches with the table the pondering has warmed up.
+template <int N, int K>
+class BasicPonderer
+{
+public:
+    typedef BasicGameLogic<N, K> Game;
+
+    BasicPonderer();
+    ~BasicPonderer();
+
+    BasicPonderer(const BasicPonderer &) = delete;
+    BasicPonderer &operator=(const BasicPonderer &) = delete;
+
+    void setSearchLimits(const SearchLimits &limits); // Per move, pondered or not
+    // Replaces the limits, and starts over with a fresh engine so nothing
+    // learnt at the old strength carries over
+    void setDifficulty(Difficulty level);
+    Difficulty getDifficulty() const;
+    void setEngineType(EngineType type);
+    EngineType getEngineType() const;
+
+    // game is the position after the AI's move, with the human to move
+    void start(const Game &game);
+    void stop();
+
+    // The AI's move in game; stops pondering first
+    int bestMove(const Game &game, const StopToken &stop = StopToken());
+    int answeredReplies() const;
+
+private:
+    std::unique_ptr<BasicEngine<N, K>> engine; // Keeps its table or tree from one move to the next
+    SearchLimits limits;
+    Difficulty difficulty;
+    Game pondered;  // Position the cached answers belong to
+    Game position;  // Pondered position plus one reply
+    std::atomic<int> answers[Game::CELL_COUNT]; // By reply cell, -1 if not searched
+    StopSource ponderStop;
+    std::thread thread;
+    std::mutex lock; // One caller at a time
+
+    void stopThread();
+    void replaceEngine(EngineType type);
+    void ponder();
+};
+
+extern template class BasicPonderer<3, 3>;
+extern template class BasicPonderer<4, 4>;
+extern template class BasicPonderer<5, 4>;
+
+typedef BasicPonderer<3, 3> Ponderer;
+
+#endif // PONDERER_H
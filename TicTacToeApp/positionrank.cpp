@@ -0,0 +1,211 @@
+// positionrank.cpp
+#include "positionrank.h"
+#include <array>
+
+namespace {
+
+constexpr int MAX_CELLS = 25;
+
+// Sum of 3^i over the set bits of a byte
+constexpr std::array<std::uint32_t, 256> makeByteDigits()
+{
+    std::array<std::uint32_t, 256> digits {};
+    for (int byte = 0; byte < 256; ++byte) {
+        for (int bit = 0; bit < 8; ++bit) {
+            if (byte & (1 << bit)) {
+                digits[byte] += static_cast<std::uint32_t>(powerOfThree(bit));
+            }
+        }
+    }
+    return digits;
+}
+
+constexpr std::array<std::uint32_t, 256> BYTE_DIGITS = makeByteDigits();
+
+constexpr std::array<std::uint64_t, MAX_CELLS + 1> makePowersOfThree()
+{
+    std::array<std::uint64_t, MAX_CELLS + 1> powers {};
+    for (int i = 0; i <= MAX_CELLS; ++i) {
+        powers[i] = powerOfThree(i);
+    }
+    return powers;
+}
+
+constexpr std::array<std::uint64_t, MAX_CELLS + 1> POWERS_OF_THREE = makePowersOfThree();
+
+struct BinomialTable
+{
+    std::uint64_t values[MAX_CELLS + 1][MAX_CELLS + 1];
+};
+
+constexpr BinomialTable makeBinomials()
+{
+    BinomialTable table {};
+    for (int n = 0; n <= MAX_CELLS; ++n) {
+        for (int k = 0; k <= MAX_CELLS; ++k) {
+            table.values[n][k] = binomial(n, k);
+        }
+    }
+    return table;
+}
+
+constexpr BinomialTable BINOMIALS = makeBinomials();
+
+// Sum of 3^i over the set bits of mask, a byte at a time
+template <typename Mask>
+std::uint64_t baseThreeDigits(Mask mask)
+{
+    std::uint64_t digits = 0;
+    for (int shift = 0; shift < int(sizeof(Mask)) * 8 && (mask >> shift); shift += 8) {
+        digits += BYTE_DIGITS[(mask >> shift) & 0xff] * POWERS_OF_THREE[shift];
+    }
+    return digits;
+}
+
+// Colex rank of a set among the sets of the same size: sum of C(e, i + 1)
+// over its elements e, the i-th smallest first
+template <typename Mask>
+std::uint64_t subsetRank(Mask set)
+{
+    std::uint64_t rank = 0;
+    for (int i = 1; set; ++i) {
+        rank += BINOMIALS.values[popLowestBit(set)][i];
+    }
+    return rank;
+}
+
+// Inverse of subsetRank() for a set of size elements below limit
+template <typename Mask>
+Mask subsetUnrank(std::uint64_t rank, int size, int limit)
+{
+    Mask set = 0;
+    for (int i = size, element = limit - 1; i > 0; --i) {
+        while (BINOMIALS.values[element][i] > rank) {
+            --element;
+        }
+        rank -= BINOMIALS.values[element][i];
+        set |= Mask(Mask(1) << element);
+        --element;
+    }
+    return set;
+}
+
+// Position of each set bit of marks within the set bits of taken
+template <typename Mask>
+Mask compress(Mask marks, Mask taken)
+{
+    Mask result = 0;
+    for (int index = 0; taken; ++index) {
+        int cell = popLowestBit(taken);
+        if (marks & Mask(Mask(1) << cell)) {
+            result |= Mask(Mask(1) << index);
+        }
+    }
+    return result;
+}
+
+// Inverse of compress(): the cells of taken picked out by the bits of marks
+template <typename Mask>
+Mask expand(Mask marks, Mask taken)
+{
+    Mask result = 0;
+    for (int index = 0; taken; ++index) {
+        int cell = popLowestBit(taken);
+        if (marks & Mask(Mask(1) << index)) {
+            result |= Mask(Mask(1) << cell);
+        }
+    }
+    return result;
+}
+
+// First legal rank of the boards with the given number of marks
+template <int Cells>
+struct LegalOffsets
+{
+    std::uint64_t first[Cells + 2];
+};
+
+template <int Cells>
+constexpr LegalOffsets<Cells> makeLegalOffsets()
+{
+    LegalOffsets<Cells> offsets {};
+    for (int marks = 0; marks <= Cells; ++marks) {
+        offsets.first[marks + 1] = offsets.first[marks] + binomial(Cells, marks) * binomial(marks, (marks + 1) / 2);
+    }
+    return offsets;
+}
+
+template <int Cells>
+constexpr LegalOffsets<Cells> LEGAL_OFFSETS = makeLegalOffsets<Cells>();
+
+} // namespace
+
+template <int N, int K>
+typename PositionRank<N, K>::Rank PositionRank<N, K>::denseRank(const Board &board)
+{
+    return baseThreeDigits(board.x) + 2 * baseThreeDigits(board.o);
+}
+
+template <int N, int K>
+typename PositionRank<N, K>::Board PositionRank<N, K>::denseUnrank(Rank rank)
+{
+    Board board = { 0, 0 };
+    for (int cell = 0; cell < N * N; ++cell, rank /= 3) {
+        if (rank % 3 == 1) board.x |= Geometry::bit(cell);
+        if (rank % 3 == 2) board.o |= Geometry::bit(cell);
+    }
+    return board;
+}
+
+template <int N, int K>
+typename PositionRank<N, K>::Rank PositionRank<N, K>::denseMoveDelta(int cell, int side)
+{
+    return (side + 1) * POWERS_OF_THREE[cell];
+}
+
+template <int N, int K>
+bool PositionRank<N, K>::isLegal(const Board &board)
+{
+    int x = bitCount(board.x);
+    int o = bitCount(board.o);
+    return !(board.x & board.o) && (x == o || x == o + 1);
+}
+
+template <int N, int K>
+typename PositionRank<N, K>::Rank PositionRank<N, K>::legalLayerStart(int marks)
+{
+    return LEGAL_OFFSETS<N * N>.first[marks];
+}
+
+template <int N, int K>
+typename PositionRank<N, K>::Rank PositionRank<N, K>::legalRank(const Board &board)
+{
+    // X's share of the marks is fixed by their number, so the taken cells
+    // and which of them are X's pick out the board
+    Mask taken = board.x | board.o;
+    int marks = bitCount(taken);
+    Rank xChoices = BINOMIALS.values[marks][(marks + 1) / 2];
+    return LEGAL_OFFSETS<N * N>.first[marks] + subsetRank(taken) * xChoices + subsetRank(compress(board.x, taken));
+}
+
+template <int N, int K>
+typename PositionRank<N, K>::Board PositionRank<N, K>::legalUnrank(Rank rank)
+{
+    int marks = 0;
+    while (LEGAL_OFFSETS<N * N>.first[marks + 1] <= rank) {
+        ++marks;
+    }
+    rank -= LEGAL_OFFSETS<N * N>.first[marks];
+
+    int xMarks = (marks + 1) / 2;
+    Rank xChoices = BINOMIALS.values[marks][xMarks];
+    Mask taken = subsetUnrank<Mask>(rank / xChoices, marks, N * N);
+    Mask x = expand(subsetUnrank<Mask>(rank % xChoices, xMarks, marks), taken);
+
+    Board board = { x, Mask(taken & ~x) };
+    return board;
+}
+
+template class PositionRank<3, 3>;
+template class PositionRank<4, 4>;
+template class PositionRank<5, 4>;
@@ -0,0 +1,80 @@
+// positionrank.h
+#ifndef POSITIONRANK_H
+#define POSITIONRANK_H
+
+#include <cstdint>
+#include "bitboard.h"
+
+constexpr std::uint64_t binomial(int n, int k)
+{
+    if (k < 0 || k > n) return 0;
+    std::uint64_t result = 1;
+    for (int i = 1; i <= k; ++i) {
+        result = result * (n - k + i) / i;
+    }
+    return result;
+}
+
+// Boards of cells cells where X has as many marks as O, or one more
+constexpr std::uint64_t legalPositionCount(int cells)
+{
+    std::uint64_t count = 0;
+    for (int marks = 0; marks <= cells; ++marks) {
+        count += binomial(cells, marks) * binomial(marks, (marks + 1) / 2);
+    }
+    return count;
+}
+
+constexpr std::uint64_t powerOfThree(int exponent)
+{
+    return exponent == 0 ? 1 : 3 * powerOfThree(exponent - 1);
+}
+
+// Dense integer indexes for the boards of one geometry, for tables indexed
+// directly by position instead of hashed.
+//
+// The dense rank is the base-3 encoding, digit i being 0 for empty, 1 for
+// X and 2 for O on cell i; on 3x3 it matches positionRank() in
+// perfectplay.h. It covers every encoding, legal or not, and a move only
+// adds one term, so a search can keep it up to date as it plays.
+//
+// The legal rank only covers boards where X, who moves first, has as many
+// marks as O or one more: 6046 of the 19683 encodings on 3x3. Boards are
+// ordered by mark count, then by which cells are taken, then by which of
+// those are X's, each in the combinatorial number system.
+template <int N, int K>
+class PositionRank
+{
+    static_assert(N * N <= 25, "ranks are tabulated up to 5x5");
+
+public:
+    typedef BoardGeometry<N, K> Geometry;
+    typedef typename Geometry::Mask Mask;
+    typedef typename Geometry::Board Board;
+    typedef std::uint64_t Rank;
+
+    static constexpr Rank DENSE_COUNT = powerOfThree(N * N);
+    static constexpr Rank LEGAL_COUNT = legalPositionCount(N * N);
+
+    static Rank denseRank(const Board &board);
+    static Board denseUnrank(Rank rank);
+
+    // Added to the dense rank when side (0 for X, 1 for O) marks cell,
+    // subtracted when the mark is taken back
+    static Rank denseMoveDelta(int cell, int side);
+
+    // The board must have as many X marks as O marks, or one more
+    static Rank legalRank(const Board &board);
+    static Board legalUnrank(Rank rank);
+    static bool isLegal(const Board &board);
+
+    // Boards with the same number of marks have consecutive legal ranks,
+    // starting here; legalLayerStart(N * N + 1) is LEGAL_COUNT
+    static Rank legalLayerStart(int marks);
+};
+
+extern template class PositionRank<3, 3>;
+extern template class PositionRank<4, 4>;
+extern template class PositionRank<5, 4>;
+
+#endif // POSITIONRANK_H
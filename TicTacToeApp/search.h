@@ -0,0 +1,60 @@
+// search.h
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <cstdint>
+
+// Budget for one AI move; zero means no limit. The time limit is checked
+// every few hundred nodes, the node limit at every node against the nodes
+// of all threads together.
+struct SearchLimits
+{
+    int maxDepth;           // Plies, counting the AI's own move
+    int timeLimitMs;
+    std::uint64_t maxNodes;
+};
+
+struct SearchResult
+{
+    int move;               // -1 when there is no empty cell
+    int score;              // From O's point of view whoever moves, 0 if nothing finished
+    int depth;              // Last fully searched depth, 0 if none finished
+    std::uint64_t nodes;
+    bool solved;            // The last finished depth reached the end of the game
+    bool stopped;           // Cut short by a stop token; move is the best found so far
+};
+
+// How search() spreads over more than one thread
+enum ParallelMode
+{
+    PARALLEL_LAZY_SMP,       // Every thread searches the whole tree, sharing the table
+    PARALLEL_YOUNG_BROTHERS  // A node's first move is searched alone, the rest split between threads
+};
+
+// How search() narrows the alpha-beta window. Every mode finds the same
+// scores; the narrower windows only prune more.
+enum SearchWindows
+{
+    WINDOWS_FULL,        // Plain alpha-beta: every move gets the node's whole window
+    WINDOWS_PVS,         // Moves after the first get a null window, re-searched if they beat it
+    WINDOWS_ASPIRATION   // PVS, and each depth opens with a narrow window around the last score
+};
+
+// Order of a node's moves after the best move stored for it in the table
+enum MoveOrdering
+{
+    ORDERING_CELLS,     // Lowest cell first
+    ORDERING_HISTORY    // The ply's killer moves, then by history, then by winning lines through the cell
+};
+
+// Work done by one thread during the last search
+struct ThreadStats
+{
+    std::uint64_t nodes;
+    std::uint64_t tasks;    // Subtrees it searched for a split node (Young Brothers Wait)
+    std::uint64_t steals;   // Of those, taken from another thread's queue
+    std::uint64_t cutoffs;  // Nodes that failed high
+    std::uint64_t firstMoveCutoffs; // Of those, on the first move tried; near cutoffs with perfect ordering
+};
+
+#endif // SEARCH_H
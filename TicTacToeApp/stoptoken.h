@@ -0,0 +1,64 @@
+// stoptoken.h
+#ifndef STOPTOKEN_H
+#define STOPTOKEN_H
+
+#include <atomic>
+#include <memory>
+
+// Stand-ins for C++20's std::stop_source and std::stop_token. A source
+// hands out tokens that all see the same flag; a default token never stops.
+class StopToken
+{
+public:
+    StopToken() = default;
+
+    bool stopPossible() const
+    {
+        return flag != nullptr;
+    }
+
+    bool stopRequested() const
+    {
+        return flag && flag->load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class StopSource;
+
+    explicit StopToken(std::shared_ptr<const std::atomic<bool>> flag)
+        : flag(std::move(flag))
+    {
+    }
+
+    std::shared_ptr<const std::atomic<bool>> flag;
+};
+
+class StopSource
+{
+public:
+    StopSource()
+        : flag(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    StopToken getToken() const
+    {
+        return StopToken(flag);
+    }
+
+    // True only for the call that actually requested the stop
+    bool requestStop()
+    {
+        return !flag->exchange(true);
+    }
+
+    bool stopRequested() const
+    {
+        return flag->load(std::memory_order_relaxed);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+#endif // STOPTOKEN_H
@@ -0,0 +1,165 @@
+// symmetry.h
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include <cstdint>
+#include "bitboard.h"
+#include "zobrist.h"
+
+// The eight rotations and reflections of a square board
+constexpr int SYMMETRY_COUNT = 8;
+
+template <int N>
+struct SymmetryTables
+{
+    typedef MaskFor<N * N> Mask;
+    static constexpr int CELLS = N * N;
+    static constexpr int CHUNKS = (CELLS + 7) / 8;
+
+    signed char cells[SYMMETRY_COUNT][CELLS];        // Where cell i lands under symmetry s
+    signed char inverseCells[SYMMETRY_COUNT][CELLS];
+    Mask chunks[SYMMETRY_COUNT][CHUNKS][256];        // Image of each byte of a mask
+};
+
+template <int N>
+constexpr SymmetryTables<N> buildSymmetryTables()
+{
+    SymmetryTables<N> tables {};
+    typedef typename SymmetryTables<N>::Mask Mask;
+
+    for (int s = 0; s < SYMMETRY_COUNT; ++s) {
+        for (int row = 0; row < N; ++row) {
+            for (int col = 0; col < N; ++col) {
+                int r = row, c = col;
+                switch (s) {
+                case 1: r = col;         c = N - 1 - row; break; // rotate 90
+                case 2: r = N - 1 - row; c = N - 1 - col; break; // rotate 180
+                case 3: r = N - 1 - col; c = row;         break; // rotate 270
+                case 4: r = row;         c = N - 1 - col; break; // mirror left-right
+                case 5: r = N - 1 - row; c = col;         break; // mirror top-bottom
+                case 6: r = col;         c = row;         break; // main diagonal
+                case 7: r = N - 1 - col; c = N - 1 - row; break; // anti-diagonal
+                default: break;                                  // identity
+                }
+                tables.cells[s][row * N + col] = static_cast<signed char>(r * N + c);
+                tables.inverseCells[s][r * N + c] = static_cast<signed char>(row * N + col);
+            }
+        }
+
+        for (int chunk = 0; chunk < SymmetryTables<N>::CHUNKS; ++chunk) {
+            for (int byte = 0; byte < 256; ++byte) {
+                Mask image = 0;
+                for (int i = 0; i < 8; ++i) {
+                    int cell = chunk * 8 + i;
+                    if ((byte & (1 << i)) && cell < SymmetryTables<N>::CELLS) {
+                        image |= Mask(Mask(1) << tables.cells[s][cell]);
+                    }
+                }
+                tables.chunks[s][chunk][byte] = image;
+            }
+        }
+    }
+    return tables;
+}
+
+template <int N>
+inline constexpr SymmetryTables<N> SYMMETRY = buildSymmetryTables<N>();
+
+// Permutes the bits of a mask a byte at a time
+template <int N, typename Mask>
+inline Mask transformMask(int symmetry, Mask mask)
+{
+    Mask image = 0;
+    for (int chunk = 0; chunk < SymmetryTables<N>::CHUNKS; ++chunk) {
+        image |= SYMMETRY<N>.chunks[symmetry][chunk][(mask >> (chunk * 8)) & 0xFF];
+    }
+    return image;
+}
+
+template <int N, typename Mask>
+inline BasicBitboard<Mask> transformBoard(const BasicBitboard<Mask> &board, int symmetry)
+{
+    BasicBitboard<Mask> image;
+    image.x = transformMask<N>(symmetry, board.x);
+    image.o = transformMask<N>(symmetry, board.o);
+    return image;
+}
+
+// The orientation with the smallest (x, o) masks represents all eight
+template <int N, typename Mask>
+inline BasicBitboard<Mask> canonicalBoard(const BasicBitboard<Mask> &board, int *symmetry = nullptr)
+{
+    BasicBitboard<Mask> best = board;
+    int bestSymmetry = 0;
+    for (int s = 1; s < SYMMETRY_COUNT; ++s) {
+        BasicBitboard<Mask> image = transformBoard<N>(board, s);
+        if (image.x < best.x || (image.x == best.x && image.o < best.o)) {
+            best = image;
+            bestSymmetry = s;
+        }
+    }
+    if (symmetry) {
+        *symmetry = bestSymmetry;
+    }
+    return best;
+}
+
+// Empty cells that are the lowest-indexed of their class under the
+// symmetries that leave the board unchanged; the other empty cells lead
+// to mirror images of positions reached through these
+template <int N, typename Mask>
+inline Mask distinctMoves(const BasicBitboard<Mask> &board)
+{
+    Mask empty = Mask(~0ull >> (64 - N * N)) & ~(board.x | board.o);
+    Mask moves = empty;
+    for (int s = 1; s < SYMMETRY_COUNT; ++s) {
+        if (transformMask<N>(s, board.x) != board.x || transformMask<N>(s, board.o) != board.o) {
+            continue;
+        }
+        Mask cells = empty;
+        while (cells) {
+            int cell = popLowestBit(cells);
+            if (SYMMETRY<N>.cells[s][cell] < cell) {
+                moves &= ~Mask(Mask(1) << cell);
+            }
+        }
+    }
+    return moves;
+}
+
+// Zobrist hashes of all eight orientations of a position, updated together.
+// The smallest of them is the same for every orientation, which makes it a
+// key shared by symmetric positions.
+struct SymmetricHash
+{
+    std::uint64_t orientations[SYMMETRY_COUNT];
+};
+
+inline void resetHash(SymmetricHash &hash)
+{
+    for (std::uint64_t &orientation : hash.orientations) {
+        orientation = ZOBRIST.emptyBoard;
+    }
+}
+
+// side is 0 for X and 1 for O
+template <int N>
+inline void toggleMark(SymmetricHash &hash, int side, int cell)
+{
+    for (int s = 0; s < SYMMETRY_COUNT; ++s) {
+        hash.orientations[s] ^= ZOBRIST.cells[side][SYMMETRY<N>.cells[s][cell]];
+    }
+}
+
+inline int canonicalOrientation(const SymmetricHash &hash)
+{
+    int best = 0;
+    for (int s = 1; s < SYMMETRY_COUNT; ++s) {
+        if (hash.orientations[s] < hash.orientations[best]) {
+            best = s;
+        }
+    }
+    return best;
+}
+
+#endif // SYMMETRY_H
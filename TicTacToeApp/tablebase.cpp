@@ -0,0 +1,391 @@
+// tablebase.cpp
+#include "tablebase.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int DISTANCE_SCORE = 100;
+
+// A move's worth to the side making it, from the entry of the position it
+// leads to: shorter wins and longer losses score higher, draws score 0
+int moveScore(std::uint8_t childEntry)
+{
+    int distance = tablebaseDistance(childEntry) + 1;
+    switch (tablebaseValue(childEntry)) {
+    case TB_LOSS: return DISTANCE_SCORE - distance;
+    case TB_WIN: return -DISTANCE_SCORE + distance;
+    default: return 0;
+    }
+}
+
+std::uint8_t entryForScore(int score)
+{
+    if (score > 0) return packTablebaseEntry(TB_WIN, DISTANCE_SCORE - score);
+    if (score < 0) return packTablebaseEntry(TB_LOSS, DISTANCE_SCORE + score);
+    return packTablebaseEntry(TB_DRAW, 0);
+}
+
+template <int N, int K>
+bool xToMove(const typename BoardGeometry<N, K>::Board &board)
+{
+    return bitCount(board.x) == bitCount(board.o);
+}
+
+// The first completed line in Geometry::LINES order decides, X before O,
+// as in GameLogic. Returns 0 for none, 1 for X, 2 for O.
+template <int N, int K>
+int winnerOf(const typename BoardGeometry<N, K>::Board &board)
+{
+    for (typename BoardGeometry<N, K>::Mask line : BoardGeometry<N, K>::LINES) {
+        if ((board.x & line) == line) return 1;
+        if ((board.o & line) == line) return 2;
+    }
+    return 0;
+}
+
+// Best move by the entries of the positions it leads to, which must all
+// be solved; entryOf maps a legal rank to its entry. -1 on a full board.
+template <int N, int K, typename EntryOf>
+int bestChild(const typename BoardGeometry<N, K>::Board &board, const EntryOf &entryOf, int &bestScore)
+{
+    typedef BoardGeometry<N, K> Geometry;
+    bool xMoves = xToMove<N, K>(board);
+    int bestMove = -1;
+    bestScore = -2 * DISTANCE_SCORE;
+    for (typename Geometry::Mask empty = Geometry::emptyCells(board); empty;) {
+        int cell = popLowestBit(empty);
+        typename Geometry::Board child = board;
+        (xMoves ? child.x : child.o) |= Geometry::bit(cell);
+        int score = moveScore(entryOf(PositionRank<N, K>::legalRank(child)));
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = cell;
+        }
+    }
+    return bestMove;
+}
+
+template <int N, int K>
+std::uint8_t solvePosition(const typename BoardGeometry<N, K>::Board &board, const std::uint8_t *entries)
+{
+    int winner = winnerOf<N, K>(board);
+    if (winner != 0) {
+        bool moverWon = (winner == 1) == xToMove<N, K>(board);
+        return packTablebaseEntry(moverWon ? TB_WIN : TB_LOSS, 0);
+    }
+    int bestScore;
+    auto entryOf = [entries](std::uint64_t rank) { return entries[rank]; };
+    if (bestChild<N, K>(board, entryOf, bestScore) < 0) {
+        return packTablebaseEntry(TB_DRAW, 0);
+    }
+    return entryForScore(bestScore);
+}
+
+std::uint64_t fnv1a(const std::uint8_t *data, std::uint64_t size)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::uint64_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint64_t readOffset(const std::uint8_t *index, std::uint64_t block)
+{
+    std::uint64_t offset;
+    std::memcpy(&offset, index + block * sizeof(offset), sizeof(offset));
+    return offset;
+}
+
+// Runs of one entry, at most 255 long, as (count, entry) pairs
+void compressBlock(const std::uint8_t *entries, std::uint64_t count, std::vector<std::uint8_t> &out)
+{
+    for (std::uint64_t i = 0; i < count;) {
+        std::uint64_t run = 1;
+        while (i + run < count && run < 255 && entries[i + run] == entries[i]) {
+            ++run;
+        }
+        out.push_back(static_cast<std::uint8_t>(run));
+        out.push_back(entries[i]);
+        i += run;
+    }
+}
+
+template <int N, int K>
+bool writeTablebaseFile(const std::string &path, const std::vector<std::uint8_t> &entries,
+                        TablebaseCompression compression)
+{
+    TablebaseHeader header {};
+    std::memcpy(header.magic, TABLEBASE_MAGIC, sizeof(header.magic));
+    header.version = TABLEBASE_VERSION;
+    header.headerSize = sizeof(TablebaseHeader);
+    header.boardSize = N;
+    header.winLength = K;
+    header.compression = static_cast<std::uint8_t>(compression);
+    header.entryCount = entries.size();
+    header.payloadOffset = TABLEBASE_PAYLOAD_OFFSET;
+
+    std::vector<std::uint8_t> payload;
+    if (compression == TB_COMPRESSION_RLE) {
+        header.blockEntries = TABLEBASE_BLOCK_ENTRIES;
+        header.blockCount = static_cast<std::uint32_t>((entries.size() + TABLEBASE_BLOCK_ENTRIES - 1) / TABLEBASE_BLOCK_ENTRIES);
+        std::vector<std::uint64_t> offsets;
+        std::vector<std::uint8_t> blocks;
+        for (std::uint64_t first = 0; first < entries.size(); first += TABLEBASE_BLOCK_ENTRIES) {
+            offsets.push_back(blocks.size());
+            compressBlock(entries.data() + first, std::min<std::uint64_t>(TABLEBASE_BLOCK_ENTRIES, entries.size() - first), blocks);
+        }
+        offsets.push_back(blocks.size());
+        payload.resize(offsets.size() * sizeof(std::uint64_t));
+        std::memcpy(payload.data(), offsets.data(), payload.size());
+        payload.insert(payload.end(), blocks.begin(), blocks.end());
+    } else {
+        payload = entries;
+    }
+    header.payloadSize = payload.size();
+    header.checksum = fnv1a(payload.data(), payload.size());
+
+    // Written aside and renamed over the old file, which stays intact for
+    // whoever has it mapped
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        std::vector<char> page(TABLEBASE_PAYLOAD_OFFSET, 0);
+        std::memcpy(page.data(), &header, sizeof(header));
+        file.write(page.data(), page.size());
+        file.write(reinterpret_cast<const char *>(payload.data()), payload.size());
+        if (!file.flush()) {
+            return false;
+        }
+    }
+#if defined(_WIN32)
+    std::remove(path.c_str());
+#endif
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool readFile(const std::string &path, std::vector<std::uint8_t> &data)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file || static_cast<std::uint64_t>(file.tellg()) != data.size()) {
+        return false;
+    }
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(data.data()), data.size());
+    return static_cast<bool>(file);
+}
+
+bool readProgress(const std::string &path, int &finishedLayer)
+{
+    std::ifstream file(path);
+    return static_cast<bool>(file >> finishedLayer);
+}
+
+// Replaced in one step, so a crash leaves the old count or the new one
+bool writeProgress(const std::string &path, int finishedLayer)
+{
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!(file << finishedLayer << '\n') || !file.flush()) {
+            return false;
+        }
+    }
+    std::remove(path.c_str());
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+} // namespace
+
+template <int N, int K>
+BasicTablebase<N, K>::BasicTablebase()
+    : header(), payload(nullptr)
+{
+}
+
+template <int N, int K>
+bool BasicTablebase<N, K>::load(const std::string &path)
+{
+    payload = nullptr;
+    if (!file.open(path) || file.size() < sizeof(TablebaseHeader)) {
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    bool valid = std::memcmp(header.magic, TABLEBASE_MAGIC, sizeof(header.magic)) == 0
+            && header.version == TABLEBASE_VERSION && header.headerSize == sizeof(TablebaseHeader)
+            && header.boardSize == N && header.winLength == K && header.entryCount == Ranking::LEGAL_COUNT
+            && header.payloadOffset >= sizeof(TablebaseHeader) && header.payloadOffset <= file.size()
+            && header.payloadSize <= file.size() - header.payloadOffset;
+    if (valid && header.compression == TB_COMPRESSION_NONE) {
+        valid = header.payloadSize == header.entryCount;
+    } else if (valid && header.compression == TB_COMPRESSION_RLE) {
+        std::uint64_t indexSize = (std::uint64_t(header.blockCount) + 1) * sizeof(std::uint64_t);
+        valid = header.blockEntries > 0
+                && header.blockCount == (header.entryCount + header.blockEntries - 1) / header.blockEntries
+                && indexSize <= header.payloadSize;
+    } else {
+        valid = false;
+    }
+    if (!valid) {
+        file.close();
+        return false;
+    }
+
+    payload = file.data() + header.payloadOffset;
+    file.adviseRandomAccess();
+    return true;
+}
+
+template <int N, int K>
+bool BasicTablebase<N, K>::isLoaded() const
+{
+    return payload != nullptr;
+}
+
+template <int N, int K>
+bool BasicTablebase<N, K>::verify() const
+{
+    return isLoaded() && fnv1a(payload, header.payloadSize) == header.checksum;
+}
+
+template <int N, int K>
+std::uint8_t BasicTablebase<N, K>::entryAt(std::uint64_t rank) const
+{
+    if (header.compression == TB_COMPRESSION_NONE) {
+        return payload[rank];
+    }
+
+    // Walk the runs of the rank's block, checking them against the payload
+    std::uint64_t indexSize = (std::uint64_t(header.blockCount) + 1) * sizeof(std::uint64_t);
+    std::uint64_t block = rank / header.blockEntries;
+    std::uint64_t skip = rank % header.blockEntries;
+    std::uint64_t begin = readOffset(payload, block);
+    std::uint64_t end = std::min(readOffset(payload, block + 1), header.payloadSize - indexSize);
+    const std::uint8_t *blocks = payload + indexSize;
+    for (std::uint64_t pair = begin; pair + 1 < end; pair += 2) {
+        if (skip < blocks[pair]) {
+            return blocks[pair + 1];
+        }
+        skip -= blocks[pair];
+    }
+    return TB_UNKNOWN;
+}
+
+template <int N, int K>
+std::uint8_t BasicTablebase<N, K>::probe(const Board &board) const
+{
+    return entryAt(Ranking::legalRank(board));
+}
+
+template <int N, int K>
+int BasicTablebase<N, K>::bestMove(const Board &board) const
+{
+    if (!isLoaded() || winnerOf<N, K>(board) != 0) {
+        return -1;
+    }
+    int bestScore;
+    auto entryOf = [this](std::uint64_t rank) { return entryAt(rank); };
+    return bestChild<N, K>(board, entryOf, bestScore);
+}
+
+template <int N, int K>
+bool buildTablebase(const std::string &path, int threadCount, const StopToken &stop,
+                    const std::function<void(int)> &layerDone, TablebaseCompression compression)
+{
+    typedef PositionRank<N, K> Ranking;
+    const int CELLS = N * N;
+    const std::uint64_t CHUNK = 4096;
+    std::string partialPath = path + ".partial";
+    std::string progressPath = path + ".progress";
+
+    if (threadCount < 1) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Resume below the last finished layer, or start over with an empty
+    // table that the progress file marks as having no layer finished
+    std::vector<std::uint8_t> entries(Ranking::LEGAL_COUNT, 0);
+    int finishedLayer;
+    if (!readProgress(progressPath, finishedLayer) || finishedLayer < 0 || finishedLayer > CELLS + 1
+            || !readFile(partialPath, entries)) {
+        std::fill(entries.begin(), entries.end(), 0);
+        std::ofstream file(partialPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char *>(entries.data()), entries.size()) || !file.flush()) {
+            return false;
+        }
+        finishedLayer = CELLS + 1;
+        if (!writeProgress(progressPath, finishedLayer)) {
+            return false;
+        }
+    }
+
+    std::fstream file(partialPath, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file) {
+        return false;
+    }
+
+    // A layer only looks at the layer with one more mark, already solved
+    for (int marks = finishedLayer - 1; marks >= 0; --marks) {
+        if (stop.stopRequested()) {
+            return false;
+        }
+
+        std::uint64_t first = Ranking::legalLayerStart(marks);
+        std::uint64_t end = Ranking::legalLayerStart(marks + 1);
+        std::atomic<std::uint64_t> nextChunk(first);
+        auto solveChunks = [&]() {
+            for (;;) {
+                std::uint64_t begin = nextChunk.fetch_add(CHUNK);
+                if (begin >= end) {
+                    return;
+                }
+                for (std::uint64_t rank = begin; rank < std::min(begin + CHUNK, end); ++rank) {
+                    entries[rank] = solvePosition<N, K>(Ranking::legalUnrank(rank), entries.data());
+                }
+            }
+        };
+        std::vector<std::thread> helpers;
+        for (int i = 1; i < threadCount; ++i) {
+            helpers.emplace_back(solveChunks);
+        }
+        solveChunks();
+        for (std::thread &helper : helpers) {
+            helper.join();
+        }
+
+        file.seekp(static_cast<std::streamoff>(first));
+        if (!file.write(reinterpret_cast<const char *>(entries.data() + first), end - first) || !file.flush()) {
+            return false;
+        }
+        if (!writeProgress(progressPath, marks)) {
+            return false;
+        }
+        if (layerDone) {
+            layerDone(marks);
+        }
+    }
+
+    file.close();
+    if (!writeTablebaseFile<N, K>(path, entries, compression)) {
+        return false;
+    }
+    std::remove(progressPath.c_str());
+    std::remove(partialPath.c_str());
+    return true;
+}
+
+template class BasicTablebase<3, 3>;
+template class BasicTablebase<4, 4>;
+template class BasicTablebase<5, 4>;
+template bool buildTablebase<3, 3>(const std::string &, int, const StopToken &, const std::function<void(int)> &,
+                                   TablebaseCompression);
+template bool buildTablebase<4, 4>(const std::string &, int, const StopToken &, const std::function<void(int)> &,
+                                   TablebaseCompression);
@@ -0,0 +1,131 @@
+// tablebase.h
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "bitboard.h"
+#include "mappedfile.h"
+#include "positionrank.h"
+#include "stoptoken.h"
+
+// Result of a position with perfect play, for the side to move. Zero is
+// left for entries that have not been solved yet.
+enum TablebaseValue { TB_UNKNOWN, TB_LOSS, TB_DRAW, TB_WIN };
+
+// One byte per position: the value in the low 2 bits, and in the rest the
+// plies until the game is won or lost (0 for draws). The winner takes the
+// shortest way there and the loser the longest, as the search does.
+inline std::uint8_t packTablebaseEntry(TablebaseValue value, int distance)
+{
+    return static_cast<std::uint8_t>(value | (distance << 2));
+}
+
+inline TablebaseValue tablebaseValue(std::uint8_t entry)
+{
+    return static_cast<TablebaseValue>(entry & 3);
+}
+
+inline int tablebaseDistance(std::uint8_t entry)
+{
+    return entry >> 2;
+}
+
+enum TablebaseCompression
+{
+    TB_COMPRESSION_NONE, // Entries stored in legal-rank order
+    TB_COMPRESSION_RLE   // Fixed-size blocks of (count, entry) byte pairs
+};
+
+// Tablebase file layout, integers little-endian. The header is padded to
+// payloadOffset, one page, so an uncompressed payload maps page-aligned.
+// A compressed payload starts with blockCount + 1 offsets (64-bit, from the
+// end of this index) of the blocks that follow, the last one marking the
+// end. The checksum is FNV-1a over the payload.
+const char TABLEBASE_MAGIC[8] = { 'T', 'T', 'T', 'B', 'A', 'S', 'E', 0 };
+const std::uint32_t TABLEBASE_VERSION = 1;
+const std::uint64_t TABLEBASE_PAYLOAD_OFFSET = 4096;
+const std::uint32_t TABLEBASE_BLOCK_ENTRIES = 4096;
+
+struct TablebaseHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint8_t boardSize;
+    std::uint8_t winLength;
+    std::uint8_t compression;
+    std::uint8_t reserved[5];
+    std::uint64_t entryCount;
+    std::uint32_t blockEntries; // Entries per compressed block
+    std::uint32_t blockCount;
+    std::uint64_t payloadOffset;
+    std::uint64_t payloadSize;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(TablebaseHeader) == 64, "the header layout is part of the file format");
+
+// Every legal position of one board solved, indexed by its legal rank. The
+// side to move is X when both sides have as many marks.
+//
+// The file is mapped, not read: loading only checks the header, entries
+// are read straight from the mapping, and pages come in as lookups touch
+// them. Compressed files decode at most one block per lookup.
+template <int N, int K>
+class BasicTablebase
+{
+public:
+    typedef BoardGeometry<N, K> Geometry;
+    typedef typename Geometry::Board Board;
+    typedef PositionRank<N, K> Ranking;
+
+    BasicTablebase();
+
+    // False if the file is missing, of another version or board, or
+    // shorter than its header says
+    bool load(const std::string &path);
+    bool isLoaded() const;
+
+    // Reads the whole payload to compare its checksum; not done by load()
+    bool verify() const;
+
+    // TB_UNKNOWN (0) for positions a damaged block does not cover
+    std::uint8_t probe(const Board &board) const;
+
+    // Move for the side to move, by the same rules as the search: fastest
+    // win, else a draw, else slowest loss, lowest cell among equals. -1 when
+    // the game is over or nothing is loaded.
+    int bestMove(const Board &board) const;
+
+private:
+    MappedFile file;
+    TablebaseHeader header;
+    const std::uint8_t *payload;
+
+    std::uint8_t entryAt(std::uint64_t rank) const;
+};
+
+// Solves every legal position by backward induction, one layer of equal
+// mark counts at a time from the full board down, splitting each layer
+// between threadCount threads. Finished layers are saved next to path as
+// they complete, with a progress file, so a build that was stopped or
+// killed resumes from the last finished layer. layerDone is called with
+// each layer's mark count. Returns true once the tablebase file is
+// written; it replaces any old one in a single rename, so processes still
+// mapping the old file keep reading it.
+template <int N, int K>
+bool buildTablebase(const std::string &path, int threadCount, const StopToken &stop = StopToken(),
+                    const std::function<void(int marks)> &layerDone = std::function<void(int)>(),
+                    TablebaseCompression compression = TB_COMPRESSION_NONE);
+
+extern template class BasicTablebase<3, 3>;
+extern template class BasicTablebase<4, 4>;
+extern template class BasicTablebase<5, 4>;
+extern template bool buildTablebase<3, 3>(const std::string &, int, const StopToken &,
+                                          const std::function<void(int)> &, TablebaseCompression);
+extern template bool buildTablebase<4, 4>(const std::string &, int, const StopToken &,
+                                          const std::function<void(int)> &, TablebaseCompression);
+
+#endif // TABLEBASE_H
@@ -1,5 +1,45 @@
 #include <QtTest/QTest>
+#include <QTemporaryDir>
 #include "test_ai.h"
+#include "allocationcounter.h"
+#include "engine.h"
+#include "mcts.h"
+#include "openingbook.h"
+#include "perfectplay.h"
+#include "ponderer.h"
+#include "tablebase.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Visits every position reachable in legal play exactly once
+void collectReachable(const GameLogic &game, std::set<int> &seen, std::vector<GameLogic> &positions)
+{
+    int key = 0;
+    for (int i = 0; i < 9; ++i) {
+        key = key * 3 + game.getCellState(i);
+    }
+    if (!seen.insert(key).second) {
+        return;
+    }
+    positions.push_back(game);
+    if (game.checkGameStatus() != GAME_ONGOING) {
+        return;
+    }
+    for (int i = 0; i < 9; ++i) {
+        GameLogic next = game;
+        if (next.makeMove(i)) {
+            collectReachable(next, seen, positions);
+        }
+    }
+}
+
+} // namespace
 
 void TestAI::initTestCase() {
     // Reset the game board for tests
@@ -65,6 +105,705 @@ void TestAI::testMinimaxDraw() {
     QCOMPARE(gameLogic.checkGameStatus(), GAME_DRAW);
 }
 
+void TestAI::testPerfectPlayMatchesSearch() {
+    // The compile-time table must pick the same move as the search, for both sides
+    std::set<int> seen;
+    std::vector<GameLogic> positions;
+    gameLogic.resetGame();
+    collectReachable(gameLogic, seen, positions);
+    QCOMPARE(int(positions.size()), 5478);
+
+    for (const GameLogic &position : positions) {
+        GameLogic game = position; // Searched copies do not keep their cache
+        QCOMPARE(game.getBestMove(), game.getBestMoveBySearch());
+    }
+}
+
+void TestAI::testTranspositionTableStats() {
+    // Transpositions on the empty board are found in the cache
+    GameLogic game;
+    game.resetTranspositionStats();
+    int firstMove = game.getBestMoveBySearch();
+    TranspositionStats first = game.getTranspositionStats();
+    QVERIFY(first.stores > 0);
+    QVERIFY(first.hits > 0);
+    QVERIFY(first.misses > 0);
+
+    // A repeated search is answered from the cache and agrees with the first
+    game.resetTranspositionStats();
+    QCOMPARE(game.getBestMoveBySearch(), firstMove);
+    TranspositionStats second = game.getTranspositionStats();
+    QVERIFY(second.hits > 0);
+    QVERIFY(second.stores < first.stores);
+}
+
+void TestAI::testLargerBoardSearch() {
+    // On 4x4 the AI (O) completes its row instead of blocking elsewhere
+    GameLogic4x4 game;
+    const int moves[] = { 0, 4, 1, 5, 8, 6, 9 };
+    for (int move : moves) {
+        QVERIFY(game.makeMove(move));
+    }
+    int move = game.getBestMove();
+    QCOMPARE(move, 7);
+    game.makeMove(move);
+    QCOMPARE(game.checkGameStatus(), PLAYER_O_WINS);
+
+    // Playing X, it completes its own row the same way
+    GameLogic4x4 first;
+    const int xMoves[] = { 4, 0, 5, 1, 6, 8 };
+    for (int xMove : xMoves) {
+        QVERIFY(first.makeMove(xMove));
+    }
+    SearchResult result = first.search();
+    QCOMPARE(result.move, 7);
+    QVERIFY(result.score < -500); // Scores stay O's
+    first.makeMove(result.move);
+    QCOMPARE(first.checkGameStatus(), PLAYER_X_WINS);
+}
+
+void TestAI::testSearchWindows() {
+    // Null windows and aspiration windows only prune: a solved position
+    // gets the same move and score from every mode, in fewer nodes than
+    // plain alpha-beta
+    const SearchWindows modes[] = { WINDOWS_FULL, WINDOWS_PVS, WINDOWS_ASPIRATION };
+    const int moves[] = { 5, 0, 10, 15, 6 };
+    SearchResult results[3];
+    for (int i = 0; i < 3; ++i) {
+        GameLogic4x4 game;
+        game.setSearchWindows(modes[i]);
+        QCOMPARE(game.getSearchWindows(), modes[i]);
+        for (int move : moves) {
+            game.makeMove(move);
+        }
+        results[i] = game.search();
+        QVERIFY(results[i].solved);
+    }
+    for (int i = 1; i < 3; ++i) {
+        QCOMPARE(results[i].move, results[0].move);
+        QCOMPARE(results[i].score, results[0].score);
+        QVERIFY(results[i].nodes < results[0].nodes);
+    }
+
+    // A depth-limited search agrees too, X to move as well as O
+    SearchLimits limits = { 6, 0, 0 };
+    for (int marks = 2; marks <= 3; ++marks) {
+        GameLogic5x5 full;
+        GameLogic5x5 narrow;
+        full.setSearchWindows(WINDOWS_FULL);
+        full.setSearchLimits(limits);
+        narrow.setSearchLimits(limits);
+        const int opening[] = { 12, 6, 18 };
+        for (int i = 0; i < marks; ++i) {
+            full.makeMove(opening[i]);
+            narrow.makeMove(opening[i]);
+        }
+        SearchResult expected = full.search();
+        SearchResult result = narrow.search();
+        QCOMPARE(result.move, expected.move);
+        QCOMPARE(result.score, expected.score);
+    }
+}
+
+void TestAI::testMoveOrdering() {
+    // Ordering changes how much is searched, never the answer
+    const int moves[] = { 12, 6, 18 };
+    SearchLimits limits = { 6, 0, 0 };
+    GameLogic5x5 plain;
+    GameLogic5x5 ordered;
+    plain.setMoveOrdering(ORDERING_CELLS);
+    QCOMPARE(plain.getMoveOrdering(), ORDERING_CELLS);
+    QCOMPARE(ordered.getMoveOrdering(), ORDERING_HISTORY);
+    plain.setSearchLimits(limits);
+    ordered.setSearchLimits(limits);
+    for (int move : moves) {
+        plain.makeMove(move);
+        ordered.makeMove(move);
+    }
+    SearchResult expected = plain.search();
+    SearchResult result = ordered.search();
+    QCOMPARE(result.move, expected.move);
+    QCOMPARE(result.score, expected.score);
+    QVERIFY(result.nodes < expected.nodes);
+
+    // Killers and history make the first move the refutation far more often
+    ThreadStats plainStats = plain.getThreadStats()[0];
+    ThreadStats orderedStats = ordered.getThreadStats()[0];
+    QVERIFY(orderedStats.cutoffs > 0);
+    QVERIFY(orderedStats.firstMoveCutoffs <= orderedStats.cutoffs);
+    double plainRate = double(plainStats.firstMoveCutoffs) / plainStats.cutoffs;
+    double orderedRate = double(orderedStats.firstMoveCutoffs) / orderedStats.cutoffs;
+    QVERIFY(orderedRate > plainRate);
+    QVERIFY(orderedRate > 0.8);
+}
+
+void TestAI::testSearchBudgets() {
+    // Without limits, 3x3 is searched to the end and agrees with the reference
+    GameLogic small;
+    small.makeMove(4);
+    SearchResult full = small.search();
+    QVERIFY(full.solved);
+    QCOMPARE(full.move, small.getBestMoveBySearch());
+
+    // A node budget stops an empty 5x5 search after the same amount of work
+    GameLogic5x5 game;
+    SearchLimits nodeLimits = { 0, 0, 20000 };
+    game.setSearchLimits(nodeLimits);
+    SearchResult first = game.search();
+    QVERIFY(first.move >= 0 && first.move < 25);
+    QVERIFY(first.depth >= 1);
+    QVERIFY(!first.solved);
+    QVERIFY(first.nodes <= nodeLimits.maxNodes);
+    GameLogic5x5 again;
+    again.setSearchLimits(nodeLimits);
+    SearchResult second = again.search();
+    QCOMPARE(second.move, first.move);
+    QCOMPARE(second.depth, first.depth);
+
+    // A time budget is honoured on a board that cannot be searched out
+    GameLogic5x5 timed;
+    SearchLimits timeLimits = { 0, 50, 0 };
+    timed.setSearchLimits(timeLimits);
+    auto start = std::chrono::steady_clock::now();
+    SearchResult result = timed.search();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    QVERIFY(result.move >= 0);
+    QVERIFY(elapsed < std::chrono::milliseconds(2 * 50 + 250)); // Slack for a loaded machine
+
+    // A depth limit caps the iterations
+    GameLogic5x5 shallow;
+    SearchLimits depthLimits = { 2, 0, 0 };
+    shallow.setSearchLimits(depthLimits);
+    QCOMPARE(shallow.search().depth, 2);
+}
+
+void TestAI::testDifficultyLevels() {
+    // Every level caps the time of a move, and the weaker ones the work too
+    for (int level = 0; level < DIFFICULTY_COUNT; ++level) {
+        DifficultySettings settings = difficultySettings(Difficulty(level));
+        QVERIFY(settings.limits.timeLimitMs > 0);
+        BasicAlphaBetaEngine<5, 4> engine;
+        engine.setDifficulty(Difficulty(level));
+        GameLogic5x5 empty;
+        auto start = std::chrono::steady_clock::now();
+        SearchResult result = engine.search(empty, StopToken());
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        QVERIFY(result.move >= 0);
+        QVERIFY(elapsed < std::chrono::milliseconds(2 * settings.limits.timeLimitMs + 250));
+        if (settings.limits.maxNodes) {
+            QVERIFY(result.nodes <= settings.limits.maxNodes);
+        }
+        if (settings.limits.maxDepth) {
+            QVERIFY(result.depth <= settings.limits.maxDepth);
+        }
+    }
+
+    // However noisy, easy takes a win in one and medium blocks one
+    GameLogic win;
+    const int winMoves[] = { 0, 4, 1, 5 };
+    for (int move : winMoves) {
+        win.makeMove(move);
+    }
+    GameLogic threat;
+    const int threatMoves[] = { 0, 4, 1 };
+    for (int move : threatMoves) {
+        threat.makeMove(move);
+    }
+    BasicAlphaBetaEngine<3, 3> easy;
+    easy.setDifficulty(DIFFICULTY_EASY);
+    BasicAlphaBetaEngine<3, 3> medium;
+    medium.setDifficulty(DIFFICULTY_MEDIUM);
+    for (int i = 0; i < 20; ++i) {
+        QCOMPARE(easy.bestMove(win, StopToken()), 2);
+        QCOMPARE(medium.bestMove(threat, StopToken()), 2);
+    }
+
+    // Perfect play is a lookup on 3x3, with no search at all
+    BasicAlphaBetaEngine<3, 3> perfect;
+    perfect.setDifficulty(DIFFICULTY_PERFECT);
+    QCOMPARE(perfect.bestMove(threat, StopToken()), perfectPlayMove(threat.getBoard()));
+
+    // The ponderer plays at the level it was given, from a fresh engine
+    Ponderer ponderer;
+    QCOMPARE(ponderer.getDifficulty(), DIFFICULTY_PERFECT);
+    ponderer.setDifficulty(DIFFICULTY_MEDIUM);
+    QCOMPARE(ponderer.getDifficulty(), DIFFICULTY_MEDIUM);
+    QCOMPARE(ponderer.bestMove(threat), 2);
+}
+
+void TestAI::testStaticEvaluation() {
+    // The incremental score agrees with a full evaluation after every move
+    typedef OpenLinesEvaluator<5, 4> Open5x5;
+    GameLogic5x5 game;
+    QCOMPARE(Open5x5::evaluate(game.getBoard()), 0);
+    const int moves[] = { 12, 6, 7, 18, 17, 0, 2, 22, 16, 11, 13, 8 };
+    int score = 0;
+    for (int move : moves) {
+        int side = game.getCurrentPlayer() == PLAYER_O ? 1 : 0;
+        score += Open5x5::moveDelta(game.getBoard(), move, side);
+        QVERIFY(game.makeMove(move));
+        QCOMPARE(score, Open5x5::evaluate(game.getBoard()));
+    }
+
+    // Three O marks in an open line outweigh X's scattered ones
+    typedef OpenLinesEvaluator<4, 4> Open4x4;
+    GameLogic4x4::Board board = { 0x0100 | 0x0020, 0x0001 | 0x0002 | 0x0004 };
+    QVERIFY(Open4x4::evaluate(board) > 0);
+
+    // At depth 1 the open-lines score prefers the centre, which lies on
+    // the most lines; without an evaluator every move ties and the lowest wins
+    SearchLimits depthOne = { 1, 0, 0 };
+    GameLogic5x5 scored;
+    scored.setSearchLimits(depthOne);
+    QCOMPARE(scored.search().move, 12);
+    GameLogic5x5 unscored;
+    unscored.setSearchLimits(depthOne);
+    unscored.setEvaluator(StaticEvaluator<GameLogic5x5::Board> { nullptr, nullptr });
+    SearchResult even = unscored.search();
+    QCOMPARE(even.move, 0);
+    QCOMPARE(even.score, 0);
+
+    // Scores cached under the old evaluator are not reused
+    SearchLimits depthTwo = { 2, 0, 0 };
+    scored.setSearchLimits(depthTwo);
+    QCOMPARE(scored.search().move, 12);
+    scored.setEvaluator(StaticEvaluator<GameLogic5x5::Board> { nullptr, nullptr });
+    SearchResult rescored = scored.search();
+    QCOMPARE(rescored.move, 0);
+    QCOMPARE(rescored.score, 0);
+}
+
+void TestAI::testParallelSearch() {
+    // Helper threads do not change a solved answer
+    GameLogic4x4 single;
+    GameLogic4x4 parallel;
+    parallel.setThreadCount(4);
+    QCOMPARE(parallel.getThreadCount(), 4);
+    const int moves[] = { 5, 0, 10, 15, 6, 9, 3 };
+    for (int move : moves) {
+        single.makeMove(move);
+        parallel.makeMove(move);
+    }
+    SearchResult expected = single.search();
+    SearchResult result = parallel.search();
+    QVERIFY(expected.solved && result.solved);
+    QCOMPARE(result.score, expected.score);
+
+    // Under a budget every thread stops and a legal move comes back. A depth
+    // budget reaches depth 2, the first that stores anything, however
+    // loaded the machine is; time and node budgets may not.
+    GameLogic5x5 game;
+    game.setThreadCount(4);
+    SearchLimits limits = { 2, 0, 0 };
+    game.setSearchLimits(limits);
+    SearchResult timed = game.search();
+    QVERIFY(game.isCellEmpty(timed.move));
+    QCOMPARE(timed.depth, 2);
+    QVERIFY(game.getTranspositionStats().stores > 0);
+}
+
+void TestAI::testYoungBrothersSearch() {
+    // Splitting the younger moves between threads keeps the solved score
+    GameLogic4x4 single;
+    GameLogic4x4 parallel;
+    parallel.setThreadCount(4);
+    parallel.setParallelMode(PARALLEL_YOUNG_BROTHERS);
+    QCOMPARE(parallel.getParallelMode(), PARALLEL_YOUNG_BROTHERS);
+    const int moves[] = { 5, 0, 10, 15, 6, 9 };
+    for (int move : moves) {
+        single.makeMove(move);
+        parallel.makeMove(move);
+    }
+    SearchResult expected = single.search();
+    SearchResult result = parallel.search();
+    QVERIFY(expected.solved && result.solved);
+    QCOMPARE(result.score, expected.score);
+    QCOMPARE(result.move, expected.move);
+
+    // Among equal root moves the lowest cell wins, as in a serial search,
+    // whichever thread finishes first
+    const std::vector<std::vector<int>> openings = { {}, { 0 }, { 5, 6, 9, 10 }, { 0, 5, 10 } };
+    for (const std::vector<int> &opening : openings) {
+        for (int threads : { 2, 3, 4 }) {
+            GameLogic4x4 serial;
+            GameLogic4x4 split;
+            split.setThreadCount(threads);
+            split.setParallelMode(PARALLEL_YOUNG_BROTHERS);
+            for (int move : opening) {
+                serial.makeMove(move);
+                split.makeMove(move);
+            }
+            SearchLimits limits = { 4, 0, 0 };
+            serial.setSearchLimits(limits);
+            split.setSearchLimits(limits);
+            SearchResult serialResult = serial.search();
+            SearchResult splitResult = split.search();
+            QCOMPARE(splitResult.move, serialResult.move);
+            QCOMPARE(splitResult.score, serialResult.score);
+        }
+    }
+
+    // Every thread's work is accounted for in the total
+    const std::vector<ThreadStats> &threads = parallel.getThreadStats();
+    QCOMPARE(static_cast<int>(threads.size()), 4);
+    std::uint64_t nodes = 0;
+    std::uint64_t tasks = 0;
+    for (const ThreadStats &thread : threads) {
+        nodes += thread.nodes;
+        tasks += thread.tasks;
+        QVERIFY(thread.steals <= thread.tasks);
+    }
+    QCOMPARE(nodes, result.nodes);
+    QVERIFY(tasks > 0);
+
+    // The budget stops the split subtrees too
+    GameLogic5x5 game;
+    game.setThreadCount(4);
+    game.setParallelMode(PARALLEL_YOUNG_BROTHERS);
+    SearchLimits limits = { 0, 50, 0 };
+    game.setSearchLimits(limits);
+    auto start = std::chrono::steady_clock::now();
+    SearchResult timed = game.search();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    QVERIFY(game.isCellEmpty(timed.move));
+    QVERIFY(timed.depth >= 1);
+    QVERIFY(elapsed < std::chrono::milliseconds(2 * 50 + 250)); // Slack for a loaded machine
+}
+
+void TestAI::testSearchAllocations() {
+    // Once the table exists, asking for a move never touches the heap
+    GameLogic game;
+    game.makeMove(4);
+    game.getBestMove();
+    game.getBestMoveBySearch();
+    std::uint64_t before = allocationCount();
+    for (int i = 0; i < 10; ++i) {
+        game.getBestMove();
+        game.getBestMoveBySearch();
+    }
+    QCOMPARE(allocationCount(), before);
+
+    // The same holds for a budgeted search on a larger board
+    GameLogic5x5 large;
+    SearchLimits limits = { 6, 0, 0 };
+    large.setSearchLimits(limits);
+    large.makeMove(12);
+    large.getBestMove();
+    before = allocationCount();
+    int move = large.getBestMove();
+    QCOMPARE(allocationCount(), before);
+    QVERIFY(large.isCellEmpty(move));
+}
+
+void TestAI::testPondering() {
+    // Every reply gets pondered, and the cached answers are the AI's moves
+    GameLogic game;
+    game.makeMove(0);
+    game.makeMove(4);
+    Ponderer ponderer;
+    ponderer.start(game);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (ponderer.answeredReplies() < 7 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    QCOMPARE(ponderer.answeredReplies(), 7);
+    for (int reply = 0; reply < 9; ++reply) {
+        GameLogic next = game;
+        if (next.makeMove(reply)) {
+            QCOMPARE(ponderer.bestMove(next), next.getBestMove());
+        }
+    }
+
+    // With the AI on X the human's replies are O's marks. A hit needs no
+    // search: even with the stop already requested, the AI takes the win a
+    // stopped search (which plays the first cell, 1) would miss.
+    GameLogic aiFirst;
+    const int opening[] = { 4, 0, 6 };
+    for (int move : opening) {
+        aiFirst.makeMove(move);
+    }
+    Ponderer secondPonderer;
+    secondPonderer.setDifficulty(DIFFICULTY_HARD);
+    secondPonderer.start(aiFirst);
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (secondPonderer.answeredReplies() < 6 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    QCOMPARE(secondPonderer.answeredReplies(), 6);
+    GameLogic careless = aiFirst;
+    careless.makeMove(8);
+    StopSource stopped;
+    stopped.requestStop();
+    QCOMPARE(secondPonderer.bestMove(careless, stopped.getToken()), 2);
+
+    // A reply that was not pondered is searched on the spot
+    GameLogic4x4 large;
+    const int moves[] = { 5, 0, 10, 15, 6, 9 };
+    for (int move : moves) {
+        large.makeMove(move);
+    }
+    BasicPonderer<4, 4> largePonderer;
+    SearchLimits limits = { 4, 0, 0 };
+    largePonderer.setSearchLimits(limits);
+    largePonderer.start(large);
+    largePonderer.stop();
+    large.makeMove(3);
+    int answer = largePonderer.bestMove(large);
+    QVERIFY(large.isCellEmpty(answer));
+}
+
+void TestAI::testStopToken() {
+    // A stop before the search starts still yields a legal move
+    GameLogic5x5 game;
+    StopSource early;
+    QVERIFY(early.requestStop());
+    QVERIFY(!early.requestStop());
+    SearchResult result = game.search(early.getToken());
+    QVERIFY(result.stopped);
+    QCOMPARE(result.depth, 0);
+    QVERIFY(game.isCellEmpty(result.move));
+
+    // An unbounded search on 5x5 ends once the stop is requested, however
+    // far it has got by then
+    StopSource source;
+    std::atomic<bool> started(false);
+    SearchResult stopped = { -1, 0, 0, 0, false, false };
+    std::thread searcher([&]() {
+        started = true;
+        stopped = game.search(source.getToken());
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    source.requestStop();
+    searcher.join();
+    QVERIFY(stopped.stopped);
+    QVERIFY(!stopped.solved);
+    QVERIFY(game.isCellEmpty(stopped.move));
+
+    // Budgets and finished searches do not report a stop, and report the
+    // depth they completed
+    SearchLimits limits = { 3, 0, 0 };
+    game.setSearchLimits(limits);
+    SearchResult bounded = game.search(StopSource().getToken());
+    QVERIFY(!bounded.stopped);
+    QCOMPARE(bounded.depth, 3);
+    QVERIFY(game.isCellEmpty(bounded.move));
+}
+
+void TestAI::testMctsEngine() {
+    // Both engines sit behind the same interface
+    QCOMPARE((makeEngine<3, 3>(ENGINE_MCTS)->type()), ENGINE_MCTS);
+    QCOMPARE((makeEngine<3, 3>(ENGINE_ALPHA_BETA)->type()), ENGINE_ALPHA_BETA);
+
+    // O takes the win, and blocks X when there is none
+    BasicMctsEngine<3, 3> engine;
+    SearchLimits limits = { 0, 0, 20000 };
+    engine.setSearchLimits(limits);
+    GameLogic win;
+    const int winMoves[] = { 0, 3, 1, 4, 8 };
+    for (int move : winMoves) {
+        win.makeMove(move);
+    }
+    SearchResult result = engine.search(win, StopToken());
+    QCOMPARE(result.move, 5);
+    QVERIFY(result.score > 50);
+    QCOMPARE(result.nodes, limits.maxNodes);
+    QCOMPARE(engine.getStats().playouts, limits.maxNodes);
+
+    GameLogic block;
+    const int blockMoves[] = { 4, 0, 2 };
+    for (int move : blockMoves) {
+        block.makeMove(move);
+    }
+    QCOMPARE(engine.search(block, StopToken()).move, 6);
+
+    // X to move works the same way
+    GameLogic xWins;
+    const int xMoves[] = { 0, 3, 1, 4 };
+    for (int move : xMoves) {
+        xWins.makeMove(move);
+    }
+    result = engine.search(xWins, StopToken());
+    QCOMPARE(result.move, 2);
+    QVERIFY(result.score < -50);
+
+    // Several threads share one tree under a time budget
+    BasicMctsEngine<5, 4> large;
+    large.setThreadCount(4);
+    SearchLimits timed = { 0, 50, 0 };
+    large.setSearchLimits(timed);
+    GameLogic5x5 empty;
+    result = large.search(empty, StopToken());
+    QVERIFY(empty.isCellEmpty(result.move));
+    QVERIFY(large.getStats().playoutsPerSecond > 0);
+    QVERIFY(large.getStats().treeNodes > 1);
+    // The same threads play the next search
+    result = large.search(empty, StopToken());
+    QVERIFY(empty.isCellEmpty(result.move));
+
+    // A finished game gets no move, whatever cells are left
+    GameLogic won;
+    const int wonMoves[] = { 0, 3, 1, 4, 2 };
+    for (int move : wonMoves) {
+        won.makeMove(move);
+    }
+    result = engine.search(won, StopToken());
+    QCOMPARE(result.move, -1);
+    QCOMPARE(result.nodes, std::uint64_t(0));
+
+    // The ponderer plays with whichever engine the game selects
+    Ponderer ponderer;
+    ponderer.setEngineType(ENGINE_MCTS);
+    ponderer.setSearchLimits(limits);
+    QCOMPARE(ponderer.getEngineType(), ENGINE_MCTS);
+    QCOMPARE(ponderer.bestMove(block), 6);
+}
+
+void TestAI::testTablebase() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    std::string path = dir.filePath("3x3.tb").toStdString();
+
+    // A build stopped after its first layer (the full boards) picks up
+    // from the next one
+    StopSource stopSource;
+    std::vector<int> layers;
+    auto stopAfterLayer = [&](int marks) {
+        layers.push_back(marks);
+        stopSource.requestStop();
+    };
+    bool complete = buildTablebase<3, 3>(path, 2, stopSource.getToken(), stopAfterLayer);
+    QVERIFY(!complete);
+    QCOMPARE(int(layers.size()), 1);
+    QCOMPARE(layers[0], 9);
+    complete = buildTablebase<3, 3>(path, 2, StopToken(), [&](int marks) { layers.push_back(marks); });
+    QVERIFY(complete);
+    QCOMPARE(int(layers.size()), 10);
+    QCOMPARE(layers[1], 8);
+    QCOMPARE(layers.back(), 0);
+
+    // The solved table agrees with the compile-time one
+    BasicTablebase<3, 3> table;
+    QVERIFY(table.load(path));
+    GameLogic::Board empty = { 0, 0 };
+    QCOMPARE(tablebaseValue(table.probe(empty)), TB_DRAW);
+    std::set<int> seen;
+    std::vector<GameLogic> positions;
+    gameLogic.resetGame();
+    collectReachable(gameLogic, seen, positions);
+    for (const GameLogic &position : positions) {
+        if (position.checkGameStatus() == GAME_ONGOING && position.getCurrentPlayer() == PLAYER_O) {
+            QCOMPARE(table.bestMove(position.getBoard()), perfectPlayMove(position.getBoard()));
+        }
+    }
+
+    // A block-compressed file answers the same; a damaged payload still
+    // loads (only the header is read) but fails verification
+    std::string compressedPath = dir.filePath("3x3-rle.tb").toStdString();
+    complete = buildTablebase<3, 3>(compressedPath, 1, StopToken(), std::function<void(int)>(), TB_COMPRESSION_RLE);
+    QVERIFY(complete);
+    BasicTablebase<3, 3> compressed;
+    QVERIFY(compressed.load(compressedPath));
+    QVERIFY(compressed.verify());
+    QVERIFY(table.verify());
+    for (std::uint64_t rank = 0; rank < PositionRank<3, 3>::LEGAL_COUNT; ++rank) {
+        GameLogic::Board board = PositionRank<3, 3>::legalUnrank(rank);
+        QCOMPARE(compressed.probe(board), table.probe(board));
+    }
+    {
+        std::fstream file(compressedPath, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(TABLEBASE_PAYLOAD_OFFSET + 100);
+        file.put(char(0x7f));
+    }
+    BasicTablebase<3, 3> damaged;
+    QVERIFY(damaged.load(compressedPath));
+    QVERIFY(!damaged.verify());
+    {
+        std::ofstream file(compressedPath, std::ios::binary | std::ios::trunc);
+        file << "not a tablebase";
+    }
+    QVERIFY(!damaged.load(compressedPath));
+    QVERIFY(!damaged.isLoaded());
+
+    // GameLogic answers X's moves from it too; other boards refuse the file
+    GameLogic game;
+    QVERIFY(game.loadTablebase(path));
+    QCOMPARE(game.getBestMove(), table.bestMove(empty));
+    GameLogic4x4 larger;
+    QVERIFY(!larger.loadTablebase(path));
+    QVERIFY(!larger.loadTablebase(dir.filePath("missing.tb").toStdString()));
+}
+
+void TestAI::testOpeningBook() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    std::string path = dir.filePath("3x3.book").toStdString();
+
+    // A whole-game 3x3 book holds every unfinished position up to symmetry
+    std::vector<std::uint64_t> entries = generateOpeningBook<3, 3>(9, 0);
+    QCOMPARE(int(entries.size()), 622);
+    bool written = writeOpeningBook<3, 3>(path, entries, 9, true);
+    QVERIFY(written);
+    BasicOpeningBook<3, 3> book;
+    QVERIFY(book.load(path));
+    QVERIFY(book.verify());
+    QCOMPARE(book.plies(), 9);
+
+    // Its moves, turned back to each position's orientation, are worth as
+    // much as the perfect ones
+    std::set<int> seen;
+    std::vector<GameLogic> positions;
+    gameLogic.resetGame();
+    collectReachable(gameLogic, seen, positions);
+    for (const GameLogic &position : positions) {
+        int move = book.probe(position.getBoard());
+        if (position.checkGameStatus() != GAME_ONGOING) {
+            QCOMPARE(move, -1);
+            continue;
+        }
+        QVERIFY(move >= 0 && position.isCellEmpty(move));
+        GameLogic fromBook = position;
+        fromBook.makeMove(move);
+        GameLogic perfect = position;
+        perfect.makeMove(perfectPlayMove(position.getBoard()));
+        QCOMPARE(fromBook.checkGameStatus(), perfect.checkGameStatus());
+        if (perfect.checkGameStatus() == GAME_ONGOING) {
+            QCOMPARE(fromBook.search().score, perfect.search().score);
+        }
+    }
+
+    // Damaged or foreign files are refused
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(OpeningBookHeader) + 3);
+        file.put(char(0x7f));
+    }
+    QVERIFY(book.load(path));
+    QVERIFY(!book.verify());
+    typedef BasicOpeningBook<4, 4> Book4x4;
+    Book4x4 other;
+    QVERIFY(!other.load(path));
+    GameLogic4x4 larger;
+    QVERIFY(!larger.loadOpeningBook(path));
+
+    // 4x4 games start from the book compiled in, whose first move keeps
+    // the draw a search to the end finds
+    Book4x4 embedded;
+    QVERIFY(embedded.loadEmbedded());
+    QVERIFY(embedded.verify());
+    QVERIFY(embedded.plies() >= 1);
+    typedef BasicOpeningBook<5, 4> Book5x5;
+    QVERIFY(!Book5x5().loadEmbedded());
+    GameLogic4x4 empty;
+    int first = empty.getBestMove();
+    QCOMPARE(first, embedded.probe(empty.getBoard()));
+    GameLogic4x4 searched;
+    searched.makeMove(searched.getBestMoveBySearch());
+    empty.makeMove(first);
+    QCOMPARE(empty.search().score, searched.search().score);
+}
+
 void TestAI::cleanupTestCase() {
     // No specific cleanup needed for now
 }
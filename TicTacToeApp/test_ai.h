@@ -14,6 +14,22 @@ private slots:
     void testMinimaxWin();
     void testMinimaxBlock();
     void testMinimaxDraw();
+    void testPerfectPlayMatchesSearch();
+    void testTranspositionTableStats();
+    void testLargerBoardSearch();
+    void testSearchWindows();
+    void testMoveOrdering();
+    void testSearchBudgets();
+    void testDifficultyLevels();
+    void testStaticEvaluation();
+    void testParallelSearch();
+    void testYoungBrothersSearch();
+    void testSearchAllocations();
+    void testPondering();
+    void testStopToken();
+    void testMctsEngine();
+    void testTablebase();
+    void testOpeningBook();
     void cleanupTestCase();
 };
 
@@ -2,6 +2,12 @@
 #include "test_gamelogic.h"
 #include "test_ai.h"
 #include "test_userauth.h"
+#include "batchstatus.h"
+#include "bitsliced.h"
+#include "perfectplay.h"
+#include "positionrank.h"
+#include "symmetry.h"
+#include <vector>
 
 void TestGameLogic::initTestCase() {
     // Initialize the game logic for testing
@@ -61,6 +67,18 @@ void TestGameLogic::testCheckGameStatusDiagonal() {
     QCOMPARE(gameLogic.checkGameStatus(), PLAYER_X_WINS);
 }
 
+void TestGameLogic::testCheckGameStatusAntiDiagonal() {
+    // Test anti-diagonal win
+    gameLogic.resetGame();
+    gameLogic.makeMove(0); // X
+    gameLogic.makeMove(2); // O
+    gameLogic.makeMove(1); // X
+    gameLogic.makeMove(4); // O
+    gameLogic.makeMove(8); // X
+    gameLogic.makeMove(6); // O
+    QCOMPARE(gameLogic.checkGameStatus(), PLAYER_O_WINS);
+}
+
 void TestGameLogic::testCheckGameStatusDraw() {
     // Test draw condition
     gameLogic.resetGame();
@@ -76,6 +94,255 @@ void TestGameLogic::testCheckGameStatusDraw() {
     QCOMPARE(gameLogic.checkGameStatus(), GAME_DRAW);
 }
 
+void TestGameLogic::testCheckGameStatusEarlyDraw() {
+    // Once every line holds both marks the game is drawn, empty cells or not
+    gameLogic.resetGame();
+    const int moves[] = { 0, 1, 2, 3, 4, 6, 7 };
+    for (int move : moves) {
+        gameLogic.makeMove(move);
+        QCOMPARE(gameLogic.checkGameStatus(), GAME_ONGOING);
+    }
+    gameLogic.makeMove(8); // O closes the last open line
+    QCOMPARE(gameLogic.checkGameStatus(), GAME_DRAW);
+    QVERIFY(gameLogic.isCellEmpty(5));
+
+    // Half a 4x4 board can already be dead
+    GameLogic4x4 game4;
+    const int moves4[] = { 0, 1, 6, 7, 9, 10, 15, 12 };
+    for (int move : moves4) {
+        QCOMPARE(game4.checkGameStatus(), GAME_ONGOING);
+        game4.makeMove(move);
+    }
+    QCOMPARE(game4.checkGameStatus(), GAME_DRAW);
+
+    // The batch and bit-sliced checks see the same draw
+    GameLogic4x4::Board board = game4.getBoard();
+    GameResult batch;
+    checkGameStatusBatch<4, 4>(&board, &batch, 1);
+    QCOMPARE(batch, GAME_DRAW);
+    GameResult sliced;
+    checkGameStatusSliced<4, 4>(&board, &sliced, 1);
+    QCOMPARE(sliced, GAME_DRAW);
+}
+
+void TestGameLogic::testBoardSymmetries() {
+    typedef GameLogic::Geometry Geometry;
+    typedef GameLogic::Mask Mask;
+
+    // Every symmetry maps winning lines onto winning lines
+    for (int s = 0; s < SYMMETRY_COUNT; ++s) {
+        for (Mask line : Geometry::LINES) {
+            Mask image = transformMask<3>(s, line);
+            bool isLine = false;
+            for (Mask other : Geometry::LINES) {
+                isLine = isLine || image == other;
+            }
+            QVERIFY(isLine);
+        }
+    }
+
+    // All orientations of a position share one canonical form
+    GameLogic::Board board = { 0x003, 0x010 }; // X on 0 and 1, O in the centre
+    GameLogic::Board canonical = canonicalBoard<3>(board);
+    for (int s = 0; s < SYMMETRY_COUNT; ++s) {
+        GameLogic::Board image = canonicalBoard<3>(transformBoard<3>(board, s));
+        QCOMPARE(image.x, canonical.x);
+        QCOMPARE(image.o, canonical.o);
+    }
+
+    // Only a corner, an edge and the centre are distinct first moves
+    GameLogic::Board empty = { 0, 0 };
+    QCOMPARE(distinctMoves<3>(empty), Mask(0x013));
+    QCOMPARE(distinctMoves<3>(board), Geometry::emptyCells(board));
+}
+
+void TestGameLogic::testLargerBoards() {
+    // 4x4 needs four in a row
+    GameLogic4x4 game4;
+    QCOMPARE(int(GameLogic4x4::Geometry::LINE_COUNT), 10);
+    const int moves4[] = { 0, 4, 1, 5, 2, 6 };
+    for (int move : moves4) {
+        QVERIFY(game4.makeMove(move));
+        QCOMPARE(game4.checkGameStatus(), GAME_ONGOING);
+    }
+    QVERIFY(game4.makeMove(3)); // X
+    QCOMPARE(game4.checkGameStatus(), PLAYER_X_WINS);
+    QVERIFY(!game4.makeMove(16));
+    QCOMPARE(game4.getCellState(16), CELL_EMPTY);
+
+    // 5x5 with four in a row, won on an off-centre anti-diagonal
+    GameLogic5x5 game5;
+    QCOMPARE(int(GameLogic5x5::Geometry::LINE_COUNT), 28);
+    const int moves5[] = { 0, 4, 1, 8, 2, 12, 24 };
+    for (int move : moves5) {
+        QVERIFY(game5.makeMove(move));
+    }
+    QCOMPARE(game5.checkGameStatus(), GAME_ONGOING);
+    QVERIFY(game5.makeMove(16)); // O completes 4-8-12-16
+    QCOMPARE(game5.checkGameStatus(), PLAYER_O_WINS);
+}
+
+void TestGameLogic::testStatusAfterGameOver() {
+    // makeMove() only checks the lines through the cell it fills
+    QCOMPARE(GameLogic::Geometry::CELL_LINES[4].count, 4);
+    QCOMPARE(GameLogic::Geometry::CELL_LINES[0].count, 3);
+    QCOMPARE(GameLogic::Geometry::CELL_LINES[1].count, 2);
+    QCOMPARE(GameLogic5x5::Geometry::CELL_LINES[12].count, 8);
+
+    // Moves after a win keep the first winning line in scan order
+    GameLogic game;
+    const int moves[] = { 0, 3, 1, 4, 2 };
+    for (int move : moves) {
+        game.makeMove(move);
+    }
+    QCOMPARE(game.checkGameStatus(), PLAYER_X_WINS);
+    QVERIFY(game.makeMove(5)); // O completes the middle row too
+    QCOMPARE(game.checkGameStatus(), PLAYER_X_WINS);
+
+    game.resetGame();
+    QCOMPARE(game.checkGameStatus(), GAME_ONGOING);
+}
+
+void TestGameLogic::testBatchStatus() {
+    const SimdLevel levels[] = { SIMD_SCALAR, SIMD_SSE42, SIMD_AVX2, SIMD_AVX512 };
+
+    // Every 3x3 encoding, reachable or not, gets the scalar answer at every
+    // level; 3^9 is not a multiple of any vector width, so the tail is covered
+    std::vector<GameLogic::Board> boards;
+    for (int rank = 0; rank < 19683; ++rank) {
+        GameLogic::Board board = { 0, 0 };
+        for (int cell = 0, r = rank; cell < 9; ++cell, r /= 3) {
+            if (r % 3 == 1) board.x |= GameLogic::Geometry::bit(cell);
+            if (r % 3 == 2) board.o |= GameLogic::Geometry::bit(cell);
+        }
+        boards.push_back(board);
+    }
+    std::vector<GameResult> expected(boards.size());
+    checkGameStatusBatch<3, 3>(boards.data(), expected.data(), boards.size(), SIMD_SCALAR);
+    QCOMPARE(expected[0], GAME_ONGOING);
+    QCOMPARE(expected[1 + 3 + 9], PLAYER_X_WINS); // Top row
+    for (SimdLevel level : levels) {
+        std::vector<GameResult> results(boards.size());
+        checkGameStatusBatch<3, 3>(boards.data(), results.data(), boards.size(), level);
+        QVERIFY(results == expected);
+    }
+
+    // Boards from played 5x5 games agree with checkGameStatus()
+    std::vector<GameLogic5x5::Board> played;
+    std::vector<GameResult> statuses;
+    for (int game = 0; game < 25; ++game) {
+        GameLogic5x5 logic;
+        for (int step = 0; step < 25 && logic.checkGameStatus() == GAME_ONGOING; ++step) {
+            logic.makeMove((game + step * 7) % 25);
+            played.push_back(logic.getBoard());
+            statuses.push_back(logic.checkGameStatus());
+        }
+    }
+    for (SimdLevel level : levels) {
+        std::vector<GameResult> results(played.size());
+        checkGameStatusBatch<5, 4>(played.data(), results.data(), played.size(), level);
+        QVERIFY(results == statuses);
+    }
+}
+
+void TestGameLogic::testBitSlicedStatus() {
+    // Every 3x3 encoding, 64 and 256 to a word group, against the scalar check
+    std::vector<GameLogic::Board> boards;
+    for (int rank = 0; rank < 19683; ++rank) {
+        GameLogic::Board board = { 0, 0 };
+        for (int cell = 0, r = rank; cell < 9; ++cell, r /= 3) {
+            if (r % 3 == 1) board.x |= GameLogic::Geometry::bit(cell);
+            if (r % 3 == 2) board.o |= GameLogic::Geometry::bit(cell);
+        }
+        boards.push_back(board);
+    }
+    std::vector<GameResult> expected(boards.size());
+    checkGameStatusBatch<3, 3>(boards.data(), expected.data(), boards.size(), SIMD_SCALAR);
+    std::vector<GameResult> results(boards.size());
+    checkGameStatusSliced<3, 3>(boards.data(), results.data(), boards.size());
+    QVERIFY(results == expected);
+    checkGameStatusSliced<3, 3, 4>(boards.data(), results.data(), boards.size());
+    QVERIFY(results == expected);
+
+    // Planes can be filled directly: X on the top row in every odd lane,
+    // O on the left column in lanes 0-7, and O on every other cell in
+    // lane 63, which fills that board but leaves it X's
+    SlicedBoards<3, 3> sliced = {};
+    for (int cell = 0; cell < 3; ++cell) {
+        sliced.x[cell][0] = 0xaaaaaaaaaaaaaaaaull;
+        sliced.o[cell * 3][0] |= 0xffull;
+    }
+    for (int cell = 0; cell < 9; ++cell) {
+        if (!(sliced.x[cell][0] & (1ull << 63))) {
+            sliced.o[cell][0] |= 1ull << 63;
+        }
+    }
+    SlicedStatus<> status;
+    evaluateSliced(sliced, status);
+    QCOMPARE(status.xWins[0], 0xaaaaaaaaaaaaaaaaull);
+    QCOMPARE(status.oWins[0], 0x55ull); // The odd lanes are X's, top row first
+    QCOMPARE(status.draw[0], 0ull);
+
+    // Played 5x5 positions, 512 to a word group
+    std::vector<GameLogic5x5::Board> played;
+    std::vector<GameResult> statuses;
+    for (int game = 0; game < 25; ++game) {
+        GameLogic5x5 logic;
+        for (int step = 0; step < 25 && logic.checkGameStatus() == GAME_ONGOING; ++step) {
+            logic.makeMove((game * 3 + step * 11) % 25);
+            played.push_back(logic.getBoard());
+            statuses.push_back(logic.checkGameStatus());
+        }
+    }
+    std::vector<GameResult> slicedStatuses(played.size());
+    checkGameStatusSliced<5, 4, 8>(played.data(), slicedStatuses.data(), played.size());
+    QVERIFY(slicedStatuses == statuses);
+}
+
+void TestGameLogic::testPositionRanking() {
+    typedef PositionRank<3, 3> Rank3x3;
+    QCOMPARE(Rank3x3::DENSE_COUNT, std::uint64_t(POSITION_COUNT));
+    QCOMPARE(Rank3x3::LEGAL_COUNT, std::uint64_t(6046));
+
+    // Dense ranks are the perfect-play encoding; legal ranks number the
+    // legal boards 0, 1, 2, ... with no gaps
+    std::vector<bool> seen(Rank3x3::LEGAL_COUNT, false);
+    for (int rank = 0; rank < POSITION_COUNT; ++rank) {
+        GameLogic::Board board = Rank3x3::denseUnrank(rank);
+        QCOMPARE(Rank3x3::denseRank(board), std::uint64_t(rank));
+        QCOMPARE(int(Rank3x3::denseRank(board)), positionRank(board));
+        if (!Rank3x3::isLegal(board)) {
+            continue;
+        }
+        std::uint64_t legal = Rank3x3::legalRank(board);
+        QVERIFY(legal < Rank3x3::LEGAL_COUNT);
+        QVERIFY(!seen[legal]);
+        seen[legal] = true;
+        GameLogic::Board back = Rank3x3::legalUnrank(legal);
+        QVERIFY(back.x == board.x && back.o == board.o);
+    }
+
+    // On 5x5 the dense rank follows a game move by move, and both ranks
+    // round-trip every position along the way
+    typedef PositionRank<5, 4> Rank5x5;
+    GameLogic5x5 game;
+    std::uint64_t rank = 0;
+    for (int step = 0; step < 25 && game.checkGameStatus() == GAME_ONGOING; ++step) {
+        int move = (step * 7 + 3) % 25;
+        rank += Rank5x5::denseMoveDelta(move, game.getCurrentPlayer() == PLAYER_O ? 1 : 0);
+        QVERIFY(game.makeMove(move));
+        GameLogic5x5::Board board = game.getBoard();
+        QCOMPARE(rank, Rank5x5::denseRank(board));
+        GameLogic5x5::Board dense = Rank5x5::denseUnrank(rank);
+        QVERIFY(dense.x == board.x && dense.o == board.o);
+        GameLogic5x5::Board legal = Rank5x5::legalUnrank(Rank5x5::legalRank(board));
+        QVERIFY(legal.x == board.x && legal.o == board.o);
+    }
+    QCOMPARE(Rank5x5::legalRank(GameLogic5x5::Board { 0, 0 }), std::uint64_t(0));
+    GameLogic5x5::Board last = Rank5x5::legalUnrank(Rank5x5::LEGAL_COUNT - 1);
+    QCOMPARE(bitCount(last.x | last.o), 25);
+}
+
 int main(int argc, char *argv[]) {
     QCoreApplication app(argc, argv);
 
@@ -13,7 +13,15 @@ private slots:
     void testCheckGameStatusHorizontal();
     void testCheckGameStatusVertical();
     void testCheckGameStatusDiagonal();
+    void testCheckGameStatusAntiDiagonal();
     void testCheckGameStatusDraw();
+    void testCheckGameStatusEarlyDraw();
+    void testBoardSymmetries();
+    void testLargerBoards();
+    void testStatusAfterGameOver();
+    void testBatchStatus();
+    void testBitSlicedStatus();
+    void testPositionRanking();
 private:
     GameLogic gameLogic;
 };
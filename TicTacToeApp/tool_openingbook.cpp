@@ -0,0 +1,102 @@
+// tool_openingbook.cpp
+// Searches the first plies of a board offline and writes the opening book
+// GameLogic::loadOpeningBook() reads.
+//
+//     TicTacToeBook [3x3|4x4|5x4] [plies] [output file] [nodes] [source file]
+//
+// With nodes 0 every position is searched to the end of the game; 5x5
+// cannot be, so its book takes a node budget per position. Given a source
+// file, the book is also written there as the embeddedOpeningBook()
+// specialization openingbook.h declares for the board; the 4x4 one is
+//
+//     TicTacToeBook 4x4 5 openingbook4x4.book 0 openingbook4x4.cpp
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "openingbook.h"
+
+namespace {
+
+bool writeSource(const std::string &path, const std::string &board, int n, int k,
+                 const std::vector<std::uint64_t> &entries, int plies)
+{
+    std::string name = path.substr(path.find_last_of("/\\") + 1);
+    std::ofstream file(path, std::ios::trunc);
+    file << "// " << name << "\n"
+         << "// Generated by TicTacToeBook " << board << " " << plies << "; do not edit.\n"
+         << "#include \"openingbook.h\"\n\n"
+         << "namespace {\n\n"
+         << "const std::uint64_t ENTRIES[] = {\n";
+    char hex[32];
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        std::snprintf(hex, sizeof(hex), "0x%016llxull,", static_cast<unsigned long long>(entries[i]));
+        file << (i % 4 == 0 ? "    " : " ") << hex << (i % 4 == 3 || i + 1 == entries.size() ? "\n" : "");
+    }
+    std::snprintf(hex, sizeof(hex), "0x%016llxull", static_cast<unsigned long long>(
+                  openingBookChecksum(entries.data(), entries.size())));
+    file << "};\n\n"
+         << "} // namespace\n\n"
+         << "template <>\n"
+         << "EmbeddedOpeningBook embeddedOpeningBook<" << n << ", " << k << ">()\n"
+         << "{\n"
+         << "    return { ENTRIES, sizeof(ENTRIES) / sizeof(ENTRIES[0]), " << plies << ", " << hex << " };\n"
+         << "}\n";
+    return static_cast<bool>(file.flush());
+}
+
+template <int N, int K>
+int build(const std::string &board, int plies, const std::string &path, std::uint64_t nodes,
+          const std::string &source)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto report = [&](std::size_t done, std::size_t total) {
+        if (done % 100 == 0 || done == total) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << done << " of " << total << " positions after " << elapsed.count() << " s" << std::endl;
+        }
+    };
+
+    std::vector<std::uint64_t> entries = generateOpeningBook<N, K>(plies, nodes, StopToken(), report);
+    if (!writeOpeningBook<N, K>(path, entries, plies, nodes == 0)) {
+        std::cerr << "Could not write " << path << std::endl;
+        return 1;
+    }
+    BasicOpeningBook<N, K> book;
+    if (!book.load(path) || !book.verify()) {
+        std::cerr << path << " does not read back" << std::endl;
+        return 1;
+    }
+    if (!source.empty() && !writeSource(source, board, N, K, entries, plies)) {
+        std::cerr << "Could not write " << source << std::endl;
+        return 1;
+    }
+    std::cout << "Empty board: X plays " << book.probe(typename BasicOpeningBook<N, K>::Board { 0, 0 })
+              << ", " << entries.size() << " positions" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string board = argc > 1 ? argv[1] : "4x4";
+    int plies = argc > 2 ? std::atoi(argv[2]) : 5;
+    std::string path = argc > 3 ? argv[3] : "openingbook" + board + ".book";
+    std::uint64_t nodes = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 0;
+    std::string source = argc > 5 ? argv[5] : "";
+
+    if (plies >= 1 && board == "3x3") {
+        return build<3, 3>(board, plies, path, nodes, source);
+    }
+    if (plies >= 1 && board == "4x4") {
+        return build<4, 4>(board, plies, path, nodes, source);
+    }
+    if (plies >= 1 && board == "5x4") {
+        return build<5, 4>(board, plies, path, nodes ? nodes : 1000000, source);
+    }
+    std::cerr << "Usage: " << argv[0] << " [3x3|4x4|5x4] [plies] [output file] [nodes] [source file]" << std::endl;
+    return 2;
+}
@@ -0,0 +1,59 @@
+// tool_tablebase.cpp
+// Solves every legal position of a board offline and writes the tablebase
+// GameLogic::loadTablebase() reads. Run it again after an interruption and
+// it resumes from the last finished layer.
+//
+//     TicTacToeTablebase [3x3|4x4] [output file] [threads] [rle]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "tablebase.h"
+
+namespace {
+
+template <int N, int K>
+int build(const std::string &path, int threads, TablebaseCompression compression)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto report = [&](int marks) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "layer " << marks << " done after " << elapsed.count() << " s" << std::endl;
+    };
+
+    std::cout << "Solving " << PositionRank<N, K>::LEGAL_COUNT << " positions into " << path << std::endl;
+    if (!buildTablebase<N, K>(path, threads, StopToken(), report, compression)) {
+        std::cerr << "Could not write " << path << std::endl;
+        return 1;
+    }
+
+    BasicTablebase<N, K> table;
+    typename BasicTablebase<N, K>::Board empty = { 0, 0 };
+    const char *values[] = { "unknown", "loss", "draw", "win" };
+    if (!table.load(path) || !table.verify()) {
+        std::cerr << path << " does not read back" << std::endl;
+        return 1;
+    }
+    std::cout << "Empty board: " << values[tablebaseValue(table.probe(empty))] << " for X" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string board = argc > 1 ? argv[1] : "4x4";
+    std::string path = argc > 2 ? argv[2] : "tablebase" + board + ".tb";
+    int threads = argc > 3 ? std::atoi(argv[3]) : 0; // 0 uses every core
+    TablebaseCompression compression = argc > 4 && std::string(argv[4]) == "rle" ? TB_COMPRESSION_RLE
+                                                                                 : TB_COMPRESSION_NONE;
+
+    if (board == "3x3") {
+        return build<3, 3>(path, threads, compression);
+    }
+    if (board == "4x4") {
+        return build<4, 4>(path, threads, compression);
+    }
+    std::cerr << "Usage: " << argv[0] << " [3x3|4x4] [output file] [threads] [rle]" << std::endl;
+    return 2;
+}
@@ -0,0 +1,115 @@
+// transpositiontable.cpp
+#include "transpositiontable.h"
+
+namespace {
+
+// data layout: score (16 bits) | bound (2) | best move + 1 (7) | depth (7)
+std::uint64_t packEntry(int score, BoundType bound, int bestMove, int depth)
+{
+    return std::uint64_t(std::uint16_t(score))
+        | std::uint64_t(bound) << 16
+        | std::uint64_t(bestMove + 1) << 18
+        | std::uint64_t(depth) << 25;
+}
+
+TranspositionEntry unpackEntry(std::uint64_t data)
+{
+    TranspositionEntry entry;
+    entry.score = std::int16_t(data & 0xFFFF);
+    entry.bound = BoundType((data >> 16) & 0x3);
+    entry.bestMove = int((data >> 18) & 0x7F) - 1;
+    entry.depth = int((data >> 25) & 0x7F);
+    return entry;
+}
+
+} // namespace
+
+TranspositionTable::TranspositionTable(std::size_t entryCount)
+{
+    resize(entryCount);
+}
+
+TranspositionTable::TranspositionTable(const TranspositionTable &other)
+    : entryCount(other.entryCount)
+{
+}
+
+TranspositionTable &TranspositionTable::operator=(const TranspositionTable &other)
+{
+    if (this != &other) {
+        entries.reset();
+        entryCount = other.entryCount;
+    }
+    return *this;
+}
+
+void TranspositionTable::resize(std::size_t count)
+{
+    std::size_t powerOfTwo = 1;
+    while (powerOfTwo * 2 <= count) {
+        powerOfTwo *= 2;
+    }
+    entryCount = powerOfTwo;
+    entries.reset();
+}
+
+std::size_t TranspositionTable::size() const
+{
+    return entryCount;
+}
+
+void TranspositionTable::allocate()
+{
+    if (!entries) {
+        entries.reset(new Slot[entryCount]);
+        clear();
+    }
+}
+
+void TranspositionTable::clear()
+{
+    if (!entries) {
+        return;
+    }
+    for (std::size_t i = 0; i < entryCount; ++i) {
+        entries[i].check.store(0, std::memory_order_relaxed);
+        entries[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool TranspositionTable::probe(std::uint64_t key, TranspositionEntry &entry, TranspositionStats &stats) const
+{
+    const Slot &slot = entries[key & (entryCount - 1)];
+    std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+    std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+
+    if ((check ^ data) == key) {
+        ++stats.hits;
+        entry = unpackEntry(data);
+        return true;
+    }
+    if (check == 0) {
+        ++stats.misses;
+    } else {
+        ++stats.collisions;
+    }
+    return false;
+}
+
+void TranspositionTable::store(std::uint64_t key, int score, BoundType bound, int bestMove, int depth,
+                               TranspositionStats &stats)
+{
+    Slot &slot = entries[key & (entryCount - 1)];
+    std::uint64_t data = packEntry(score, bound, bestMove, depth);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+    ++stats.stores;
+}
+
+void addStats(TranspositionStats &total, const TranspositionStats &part)
+{
+    total.hits += part.hits;
+    total.misses += part.misses;
+    total.collisions += part.collisions;
+    total.stores += part.stores;
+}
@@ -0,0 +1,65 @@
+// transpositiontable.h
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+enum BoundType { BOUND_EXACT, BOUND_LOWER, BOUND_UPPER };
+
+struct TranspositionEntry
+{
+    int score;      // Relative to the stored node, not the search root
+    BoundType bound;
+    int bestMove;   // -1 when unknown
+    int depth;      // Plies searched below the node
+};
+
+struct TranspositionStats
+{
+    std::uint64_t hits;       // Slot held the probed position
+    std::uint64_t misses;     // Slot was empty
+    std::uint64_t collisions; // Slot held a different position
+    std::uint64_t stores;
+};
+
+// Direct-mapped, always-replace cache of search results, shared by all
+// search threads without locks. Each slot holds the packed entry and the
+// key XOR the packed entry; a slot torn by two threads writing at once no
+// longer XORs back to its key and reads as empty.
+//
+// The table is allocated on first use, and copying a GameLogic copies the
+// size of its table but not the cached positions. Statistics are counted
+// by the caller, one set per search thread.
+class TranspositionTable
+{
+public:
+    explicit TranspositionTable(std::size_t entryCount = 1 << 16);
+    TranspositionTable(const TranspositionTable &other);
+    TranspositionTable &operator=(const TranspositionTable &other);
+
+    void resize(std::size_t entryCount); // Rounded down to a power of two
+    std::size_t size() const;
+    void allocate(); // Must happen before several threads use the table
+    void clear();
+
+    bool probe(std::uint64_t key, TranspositionEntry &entry, TranspositionStats &stats) const;
+    void store(std::uint64_t key, int score, BoundType bound, int bestMove, int depth,
+               TranspositionStats &stats);
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> check; // key ^ data, 0 when unused
+        std::atomic<std::uint64_t> data;
+    };
+
+    std::unique_ptr<Slot[]> entries;
+    std::size_t entryCount;
+};
+
+void addStats(TranspositionStats &total, const TranspositionStats &part);
+
+#endif // TRANSPOSITIONTABLE_H
@@ -0,0 +1,183 @@
+// workstealingpool.cpp
+#include "workstealingpool.h"
+#include <algorithm>
+
+namespace {
+
+// The pool the current thread was started by, and its index there; set
+// only by the pool's own threads
+thread_local const WorkStealingPool *currentPool = nullptr;
+thread_local int currentIndex = -1;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : shuttingDown(false), events(0), sleepers(0)
+{
+    if (threadCount < 1) {
+        threadCount = 1;
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        queues.emplace_back(new WorkerQueue());
+        queues.back()->counters = WorkerCounters();
+    }
+
+    for (int i = 1; i < threadCount; ++i) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    shuttingDown = true;
+    signal(true);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+int WorkStealingPool::threadCount() const
+{
+    return static_cast<int>(queues.size());
+}
+
+int WorkStealingPool::currentWorker() const
+{
+    return currentPool == this ? currentIndex : 0;
+}
+
+const WorkerCounters &WorkStealingPool::counters(int worker) const
+{
+    return queues[worker]->counters;
+}
+
+void WorkStealingPool::resetCounters()
+{
+    for (std::unique_ptr<WorkerQueue> &queue : queues) {
+        queue->counters = WorkerCounters();
+    }
+}
+
+void WorkStealingPool::submit(TaskGroup &group, std::function<void()> task)
+{
+    int worker = currentWorker();
+    group.pending.fetch_add(1);
+
+    {
+        WorkerQueue &queue = *queues[worker];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.push_back(Task { &group, std::move(task) });
+    }
+    signal(false);
+}
+
+void WorkStealingPool::wait(TaskGroup &group)
+{
+    int worker = currentWorker();
+    while (group.pending.load() > 0) {
+        std::uint64_t seen = events.load();
+        if (!runOneTask(worker) && group.pending.load() > 0) {
+            sleepUnlessSignalled(seen);
+        }
+    }
+}
+
+void WorkStealingPool::workerLoop(int worker)
+{
+    currentPool = this;
+    currentIndex = worker;
+    while (!shuttingDown.load()) {
+        std::uint64_t seen = events.load();
+        if (!runOneTask(worker) && !shuttingDown.load()) {
+            sleepUnlessSignalled(seen);
+        }
+    }
+}
+
+void WorkStealingPool::signal(bool everyone)
+{
+    // Counted before the sleepers are read: a thread that has not gone to
+    // sleep yet sees the new count and stays awake
+    events.fetch_add(1);
+    if (sleepers.load() > 0) {
+        std::lock_guard<std::mutex> guard(idleLock);
+        if (everyone) {
+            wakeup.notify_all();
+        } else {
+            wakeup.notify_one();
+        }
+    }
+}
+
+void WorkStealingPool::sleepUnlessSignalled(std::uint64_t seen)
+{
+    sleepers.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> guard(idleLock);
+        wakeup.wait(guard, [&] { return events.load() != seen; });
+    }
+    sleepers.fetch_sub(1);
+}
+
+bool WorkStealingPool::runOneTask(int worker)
+{
+    Task task;
+    bool found = false;
+    bool stolen = false;
+
+    // Own deque first, newest task
+    {
+        WorkerQueue &own = *queues[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Otherwise the oldest task of the next thread that has one
+    for (int i = 1; !found && i < threadCount(); ++i) {
+        WorkerQueue &victim = *queues[(worker + i) % threadCount()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            found = true;
+            stolen = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    task.run();
+    ++queues[worker]->counters.tasks;
+    if (stolen) {
+        ++queues[worker]->counters.steals;
+    }
+    // Whoever waits on the group may be asleep
+    if (task.group->pending.fetch_sub(1) == 1) {
+        signal(true);
+    }
+    return true;
+}
+
+ReusablePool::ReusablePool(const ReusablePool &)
+{
+}
+
+ReusablePool &ReusablePool::operator=(const ReusablePool &)
+{
+    return *this;
+}
+
+WorkStealingPool &ReusablePool::get(int threadCount)
+{
+    if (!pool || pool->threadCount() != std::max(1, threadCount)) {
+        pool.reset();
+        pool.reset(new WorkStealingPool(threadCount));
+    }
+    return *pool;
+}
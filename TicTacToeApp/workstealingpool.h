@@ -0,0 +1,105 @@
+// workstealingpool.h
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Tasks submitted together; wait() returns once all of them have run
+struct TaskGroup
+{
+    std::atomic<int> pending{0};
+};
+
+struct WorkerCounters
+{
+    std::uint64_t tasks;  // Tasks run by this thread
+    std::uint64_t steals; // Of those, taken from another thread's deque
+};
+
+// Fork-join pool with one deque per thread. A thread pushes and pops its
+// own tasks at the back (newest first, best for cache and depth-first
+// order) and steals the oldest task at the front of another thread's
+// deque, which is usually the biggest piece of work left.
+//
+// The pool starts threadCount - 1 threads. Worker 0 is the outside thread
+// driving the pool, one at a time, and only runs tasks while it waits. A
+// waiting thread runs other tasks until its group is done, so tasks may
+// submit and wait on groups of their own. Threads with nothing to run or
+// steal sleep until a task is submitted or a group finishes, leaving the
+// cores to the threads that have work.
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(int threadCount);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    int threadCount() const;
+    void submit(TaskGroup &group, std::function<void()> task);
+    void wait(TaskGroup &group);
+
+    // Index of the calling thread in this pool; 0 for the outside thread
+    // driving it
+    int currentWorker() const;
+    const WorkerCounters &counters(int worker) const;
+    void resetCounters(); // Only while no task runs
+
+private:
+    struct Task
+    {
+        TaskGroup *group;
+        std::function<void()> run;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex lock;
+        std::deque<Task> tasks;
+        WorkerCounters counters;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<bool> shuttingDown;
+
+    // Idle threads sleep on wakeup until events moves past the count they
+    // saw before looking for work, so nothing submitted after that is missed
+    std::mutex idleLock;
+    std::condition_variable wakeup;
+    std::atomic<std::uint64_t> events;
+    std::atomic<int> sleepers;
+
+    void workerLoop(int worker);
+    bool runOneTask(int worker);
+    void signal(bool everyone);
+    void sleepUnlessSignalled(std::uint64_t seen);
+};
+
+// A pool started on first use and kept for the uses after it, so its
+// threads are not started and joined again each time. It is replaced only
+// when another thread count is asked for. Copies start without one, as a
+// pool is driven by one outside thread at a time.
+class ReusablePool
+{
+public:
+    ReusablePool() = default;
+    ReusablePool(const ReusablePool &other);
+    ReusablePool &operator=(const ReusablePool &other);
+
+    WorkStealingPool &get(int threadCount);
+
+private:
+    std::unique_ptr<WorkStealingPool> pool;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,45 @@
+// zobrist.h
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+constexpr int ZOBRIST_MAX_CELLS = 64;
+
+// One random key per (side, cell); a position's hash is the XOR of the keys
+// of its marks, so placing or removing a mark is a single XOR. The keys
+// are shared by every board size.
+struct ZobristKeys
+{
+    std::uint64_t cells[2][ZOBRIST_MAX_CELLS]; // [0] = X, [1] = O
+    std::uint64_t oToMove;
+    // Salt, so at least the empty board's key is not 0. Any other position
+    // can still hash to 0, which an empty table slot matches, with odds of
+    // one in 2^64.
+    std::uint64_t emptyBoard;
+};
+
+constexpr std::uint64_t splitMix64(std::uint64_t &state)
+{
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+constexpr ZobristKeys makeZobristKeys(std::uint64_t seed)
+{
+    ZobristKeys keys {};
+    for (int side = 0; side < 2; ++side) {
+        for (int cell = 0; cell < ZOBRIST_MAX_CELLS; ++cell) {
+            keys.cells[side][cell] = splitMix64(seed);
+        }
+    }
+    keys.oToMove = splitMix64(seed);
+    keys.emptyBoard = splitMix64(seed);
+    return keys;
+}
+
+inline constexpr ZobristKeys ZOBRIST = makeZobristKeys(0x746963746163746Full);
+
+#endif // ZOBRIST_H